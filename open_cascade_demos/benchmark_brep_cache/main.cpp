@@ -0,0 +1,128 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the binary BRep cache against the STEP files for every demo model
+//  Usage: benchmark_brep_cache [number_of_repetitions]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+#include "brep_cache.h"
+#include "demo_models.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Size of a file in kilobytes
+// ------------------------------------------------------------------------------------------------------------------ //
+double file_size_kilobytes(const string &file_name) {
+
+    struct stat file_status;
+    if (stat(file_name.c_str(), &file_status) != 0) { return 0.0; }
+    return file_status.st_size / 1024.0;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Load the models of the demonstration scripts
+    // -------------------------------------------------------------------------------------------------------------- //
+    int number_of_repetitions = argc > 1 ? atoi(argv[1]) : 100;
+    if (number_of_repetitions <= 0) {
+        cerr << "The number of repetitions must be a positive integer (got " << argv[1] << ")" << endl;
+        return 1;
+    }
+    vector<DemoModel> models = load_demo_models();
+    if (models.empty()) {
+        cout << "No demo models found. Run the demonstration scripts first." << endl;
+        return 1;
+    }
+
+    string relative_path = "../output/";
+    StepExporter step_exporter;
+    int number_of_failures = 0;
+
+    cout << "\n\nAverage time per model over " << number_of_repetitions << " repetitions (milliseconds)" << endl;
+    cout << setw(40) << "Demo" << setw(12) << "STEP [kB]" << setw(12) << "BRep [kB]"
+         << setw(12) << "STEP write" << setw(12) << "BRep write"
+         << setw(12) << "STEP read" << setw(12) << "BRep read" << setw(12) << "Speed-up" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Compare the write and read times of both formats for every model
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (const DemoModel &model : models) {
+
+        string step_file_name = relative_path + model.demo_name + ".step";
+        string brep_file_name = relative_path + model.demo_name + BREP_CACHE_EXTENSION;
+        TopoDS_Shape shape;
+
+        // Write the STEP file
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < number_of_repetitions; ++i) {
+            step_exporter.write(relative_path, model.demo_name, model.model_object);
+        }
+        double step_write = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Write the binary BRep file
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < number_of_repetitions; ++i) {
+            write_brep_file(relative_path, model.demo_name, model.model_object);
+        }
+        double brep_write = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Read the STEP file
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < number_of_repetitions; ++i) {
+            if (!read_step_file(step_file_name, shape)) { number_of_failures++; }
+        }
+        double step_read = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Read the binary BRep file
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < number_of_repetitions; ++i) {
+            if (!read_brep_file(brep_file_name, shape)) { number_of_failures++; }
+        }
+        double brep_read = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << setw(40) << model.demo_name
+             << setw(12) << file_size_kilobytes(step_file_name) << setw(12) << file_size_kilobytes(brep_file_name)
+             << setw(12) << step_write / number_of_repetitions << setw(12) << brep_write / number_of_repetitions
+             << setw(12) << step_read / number_of_repetitions << setw(12) << brep_read / number_of_repetitions
+             << setw(12) << step_read / brep_read << endl;
+
+    }
+
+    cout << "\n\nFailed reads: " << number_of_failures << endl;
+
+
+    return number_of_failures == 0 ? 0 : 1;
+
+
+}
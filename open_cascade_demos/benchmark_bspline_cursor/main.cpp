@@ -0,0 +1,204 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the sequential sampling of B-Spline curves, surfaces and laws
+//  The cursors of bspline_cursor.h are compared with the evaluators of OpenCascade (D0 and Value)
+//  Usage: benchmark_bspline_cursor [number_of_samples]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Law_BSpline.hxx>
+
+
+// Include the shared demo library
+#include "bspline_cursor.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Clamped knot vector with equispaced knots (as in the demos), the arrays have the indices 0, ..., poles - degree
+// ------------------------------------------------------------------------------------------------------------------ //
+void fill_knots(int degree, TColStd_Array1OfReal &knots, TColStd_Array1OfInteger &mults) {
+
+    int N = knots.Upper();
+    for (int i = 0; i <= N; ++i) {
+        knots(i) = double(i) / double(N);
+        mults(i) = (i == 0 || i == N) ? degree + 1 : 1;
+    }
+
+}
+
+
+// Print one row of the table
+void print_row(const string &name, size_t number_of_samples, double reference, double cursor, size_t span_changes,
+               double error) {
+
+    cout << setw(28) << name << setw(12) << number_of_samples << setw(12) << reference << setw(12) << cursor
+         << setw(10) << reference / max(cursor, 1e-6) << setw(14) << span_changes << setw(12) << error << endl;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    size_t number_of_samples = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    mt19937 generator(0);
+    uniform_real_distribution<double> distribution(0.5, 1.5);
+
+    cout << "\n\nSampling at increasing parameters (times in milliseconds, largest distance to the OpenCascade "
+         << "evaluator)" << endl;
+    cout << setw(28) << "B-Spline" << setw(12) << "Samples" << setw(12) << "OpenCascade" << setw(12) << "Cursor"
+         << setw(10) << "Speed-up" << setw(14) << "Span changes" << setw(12) << "Error" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Curves and laws with 64 poles
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (int degree : {3, 5}) {
+        for (bool rational : {false, true}) {
+
+            int number_of_poles = 64;
+            TColgp_Array1OfPnt poles(1, number_of_poles);
+            TColStd_Array1OfReal law_poles(1, number_of_poles), weights(1, number_of_poles);
+            for (int i = 1; i <= number_of_poles; ++i) {
+                poles(i) = gp_Pnt(i, distribution(generator), distribution(generator));
+                law_poles(i) = distribution(generator);
+                weights(i) = distribution(generator);
+            }
+            TColStd_Array1OfReal knots(0, number_of_poles - degree);
+            TColStd_Array1OfInteger mults(0, number_of_poles - degree);
+            fill_knots(degree, knots, mults);
+
+            Handle(Geom_BSplineCurve) curve = rational ? new Geom_BSplineCurve(poles, weights, knots, mults, degree)
+                                                       : new Geom_BSplineCurve(poles, knots, mults, degree);
+            Handle(Law_BSpline) law = rational ? new Law_BSpline(law_poles, weights, knots, mults, degree)
+                                               : new Law_BSpline(law_poles, knots, mults, degree);
+            string suffix = ", p=" + to_string(degree) + (rational ? ", NURBS" : "");
+
+            // Curve
+            double error = 0.0;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) {
+                curve->Value(double(i) / double(number_of_samples - 1));
+            }
+            double reference = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            BSplineCurveCursor curve_cursor(curve);
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) {
+                curve_cursor.value(double(i) / double(number_of_samples - 1));
+            }
+            double cursor = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            for (size_t i = 0; i < number_of_samples; i += 97) {
+                double u = double(i) / double(number_of_samples - 1);
+                error = max(error, curve_cursor.value(u).Distance(curve->Value(u)));
+            }
+            print_row("curve" + suffix, number_of_samples, reference, cursor,
+                      curve_cursor.span_cursor().number_of_span_changes(), error);
+
+            // Law
+            error = 0.0;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) {
+                law->Value(double(i) / double(number_of_samples - 1));
+            }
+            reference = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            BSplineLawCursor law_cursor(*law);
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) {
+                law_cursor.value(double(i) / double(number_of_samples - 1));
+            }
+            cursor = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            for (size_t i = 0; i < number_of_samples; i += 97) {
+                double u = double(i) / double(number_of_samples - 1);
+                error = max(error, fabs(law_cursor.value(u) - law->Value(u)));
+            }
+            print_row("law" + suffix, number_of_samples, reference, cursor,
+                      law_cursor.span_cursor().number_of_span_changes(), error);
+
+        }
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Surfaces with 16 x 16 poles sampled on a square grid (v inside u)
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (bool rational : {false, true}) {
+
+        int number_of_poles = 16, degree = 3;
+        TColgp_Array2OfPnt poles(1, number_of_poles, 1, number_of_poles);
+        TColStd_Array2OfReal weights(1, number_of_poles, 1, number_of_poles);
+        for (int i = 1; i <= number_of_poles; ++i) {
+            for (int j = 1; j <= number_of_poles; ++j) {
+                poles(i, j) = gp_Pnt(i, j, distribution(generator));
+                weights(i, j) = distribution(generator);
+            }
+        }
+        TColStd_Array1OfReal knots(0, number_of_poles - degree);
+        TColStd_Array1OfInteger mults(0, number_of_poles - degree);
+        fill_knots(degree, knots, mults);
+        Handle(Geom_BSplineSurface) surface =
+                rational ? new Geom_BSplineSurface(poles, weights, knots, knots, mults, mults, degree, degree)
+                         : new Geom_BSplineSurface(poles, knots, knots, mults, mults, degree, degree);
+
+        size_t grid_size = size_t(sqrt(double(number_of_samples)));
+        double step = 1.0 / double(grid_size - 1), error = 0.0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t i = 0; i < grid_size; ++i) {
+            for (size_t j = 0; j < grid_size; ++j) { surface->Value(i * step, j * step); }
+        }
+        double reference = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        BSplineSurfaceCursor surface_cursor(surface);
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < grid_size; ++i) {
+            for (size_t j = 0; j < grid_size; ++j) { surface_cursor.value(i * step, j * step); }
+        }
+        double cursor = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        for (size_t i = 0; i < grid_size; i += 7) {
+            for (size_t j = 0; j < grid_size; j += 7) {
+                gp_Pnt point = surface->Value(i * step, j * step);
+                error = max(error, surface_cursor.value(i * step, j * step).Distance(point));
+            }
+        }
+        print_row(string("surface 16x16, p=3") + (rational ? ", NURBS" : ""), grid_size * grid_size, reference, cursor,
+                  surface_cursor.number_of_patch_changes(), error);
+
+    }
+
+
+    return 0;
+
+
+}
@@ -0,0 +1,161 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the sampling of B-Spline evolution laws
+//  The batch evaluator of bspline_law_evaluator.h is compared with a loop over Law_BSpline::Value and Law_BSpline::D1
+//  The program fails (exit code 1) if an error exceeds MAX_LAW_ERROR_IN_ULPS
+//  Usage: benchmark_bspline_law [maximum_number_of_samples]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Law_BSpline.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+
+
+// Include the shared demo library
+#include "bspline_law_evaluator.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Clamped B-Spline law with equispaced knots and random poles (and random weights if rational)
+// ------------------------------------------------------------------------------------------------------------------ //
+Handle(Law_BSpline) make_law(int number_of_poles, int degree, bool rational) {
+
+    mt19937 generator(number_of_poles);
+    uniform_real_distribution<double> pole_distribution(0.5, 1.5);
+    uniform_real_distribution<double> weight_distribution(0.5, 2.0);
+
+    TColStd_Array1OfReal poles(1, number_of_poles);
+    TColStd_Array1OfReal weights(1, number_of_poles);
+    for (int i = 1; i <= number_of_poles; ++i) {
+        poles(i) = pole_distribution(generator);
+        weights(i) = weight_distribution(generator);
+    }
+
+    // Same knot vector as demo_evolution_law
+    int N = number_of_poles - degree;
+    TColStd_Array1OfReal knots(0, N);
+    TColStd_Array1OfInteger multiplicities(0, N);
+    for (int i = 0; i <= N; ++i) {
+        knots(i) = double(i) / double(N);
+        multiplicities(i) = (i == 0 || i == N) ? degree + 1 : 1;
+    }
+
+    if (rational) { return new Law_BSpline(poles, weights, knots, multiplicities, degree); }
+    return new Law_BSpline(poles, knots, multiplicities, degree);
+
+}
+
+
+// Largest difference between two arrays, in units of the machine epsilon times the largest magnitude of the reference
+double error_in_ulps(const vector<double> &values, const vector<double> &reference) {
+
+    double largest_difference = 0.0, largest_value = 0.0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        largest_difference = max(largest_difference, fabs(values[i] - reference[i]));
+        largest_value = max(largest_value, fabs(reference[i]));
+    }
+    return largest_difference / (numeric_limits<double>::epsilon() * max(1.0, largest_value));
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    size_t maximum_number_of_samples = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+
+    cout << "\n\nSampling of B-Spline laws at sorted parameters (times in milliseconds, errors in units of the machine "
+         << "epsilon, " << BSplineLawEvaluator::instruction_set() << " evaluator)" << endl;
+    cout << setw(22) << "Law" << setw(12) << "Samples" << setw(12) << "Value loop" << setw(12) << "Batch"
+         << setw(10) << "Speed-up" << setw(12) << "D1 loop" << setw(12) << "Batch D1" << setw(10) << "Speed-up"
+         << setw(12) << "Error" << setw(12) << "Error D1" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+    struct LawCase { string name; int number_of_poles; int degree; bool rational; };
+    vector<LawCase> cases = {{"demo (5 poles, p=3)", 5, 3, false},
+                             {"64 poles, p=3", 64, 3, false},
+                             {"64 poles, p=5", 64, 5, false},
+                             {"64 poles, p=3, NURBS", 64, 3, true}};
+
+    double largest_error = 0.0;
+    for (const LawCase &law_case : cases) {
+
+        Handle(Law_BSpline) law = make_law(law_case.number_of_poles, law_case.degree, law_case.rational);
+        BSplineLawEvaluator evaluator(*law);
+
+        for (size_t number_of_samples = 1000; number_of_samples <= maximum_number_of_samples; number_of_samples *= 10) {
+
+            // Equispaced parameters, as in demo_evolution_law
+            vector<double> u(number_of_samples);
+            for (size_t i = 0; i < number_of_samples; ++i) { u[i] = double(i) / double(number_of_samples - 1); }
+
+            // Loops over the parameters
+            vector<double> reference_values(number_of_samples), reference_derivatives(number_of_samples);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) { reference_values[i] = law->Value(u[i]); }
+            double value_loop = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < number_of_samples; ++i) {
+                law->D1(u[i], reference_values[i], reference_derivatives[i]);
+            }
+            double derivative_loop = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            // Batch evaluation
+            vector<double> values, derivatives;
+            start = chrono::steady_clock::now();
+            evaluator.evaluate(u, values);
+            double batch = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            evaluator.evaluate(u, values, derivatives);
+            double batch_derivative = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            double error = error_in_ulps(values, reference_values);
+            double derivative_error = error_in_ulps(derivatives, reference_derivatives);
+            largest_error = max(largest_error, max(error, derivative_error));
+
+            cout << setw(22) << law_case.name << setw(12) << number_of_samples
+                 << setw(12) << value_loop << setw(12) << batch << setw(10) << value_loop / max(batch, 1e-6)
+                 << setw(12) << derivative_loop << setw(12) << batch_derivative
+                 << setw(10) << derivative_loop / max(batch_derivative, 1e-6)
+                 << setw(12) << error << setw(12) << derivative_error << endl;
+
+        }
+    }
+
+    // Check the results against the tolerance of the evaluator
+    if (largest_error > MAX_LAW_ERROR_IN_ULPS) {
+        cerr << "\nThe batch evaluator differs from Law_BSpline by " << largest_error << " ulps (tolerance "
+             << MAX_LAW_ERROR_IN_ULPS << ")" << endl;
+        return 1;
+    }
+    cout << "\nLargest error: " << largest_error << " ulps (tolerance " << MAX_LAW_ERROR_IN_ULPS << ")" << endl;
+
+
+    return 0;
+
+
+}
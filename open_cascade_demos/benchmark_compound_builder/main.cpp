@@ -0,0 +1,121 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the assembly of compounds with BRep_Builder at 1k, 100k and 1M children
+//
+//  OpenCascade keeps the children of a TopoDS_TShape in a TopoDS_ListOfShape (an NCollection_List), which has no
+//  reserve and whose allocator cannot be chosen from outside TopoDS: every BRep_Builder::Add allocates one list node,
+//  and a builder that stages the children in a preallocated vector still pays that allocation when it creates the
+//  compound. The benchmark measures the plain loop of BRep_Builder::Add calls (the baseline of any such builder) and
+//  the cost of creating the located children, to show how the assembly time splits between the two.
+//  Usage: benchmark_compound_builder
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopoDS_Shape.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Located instance number i of a box on a line (creating a child allocates its location only)
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Shape make_child(const TopoDS_Shape &prototype, size_t i) {
+
+    gp_Trsf translation;
+    translation.SetTranslation(gp_Vec(2.0 * double(i), 0.0, 0.0));
+    return prototype.Moved(TopLoc_Location(translation));
+
+}
+
+
+// Number of children of a compound
+size_t count_children(const TopoDS_Shape &compound) {
+
+    size_t number_of_children = 0;
+    for (TopoDS_Iterator iterator(compound); iterator.More(); iterator.Next()) { number_of_children++; }
+    return number_of_children;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    TopoDS_Shape prototype = BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 1.0, 1.0, 1.0).Shape();
+
+    cout << "\n\nAssembly of a compound with BRep_Builder (times in milliseconds, per child in nanoseconds)" << endl;
+    cout << setw(10) << "Children" << setw(16) << "Make children" << setw(16) << "Add loop" << setw(16)
+         << "Make + Add" << setw(14) << "Add/child" << setw(10) << "Match" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Time the creation of the children and the loop of BRep_Builder::Add calls, apart and together
+    // -------------------------------------------------------------------------------------------------------------- //
+    bool all_match = true;
+    for (size_t number_of_children : {size_t(1000), size_t(100000), size_t(1000000)}) {
+
+        // Located children collected in a vector (as when they are built in parallel, see parallel_build.h)
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<TopoDS_Shape> children;
+        children.reserve(number_of_children);
+        for (size_t i = 0; i < number_of_children; ++i) { children.push_back(make_child(prototype, i)); }
+        double make_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // One BRep_Builder::Add call per child of the vector
+        start = chrono::steady_clock::now();
+        BRep_Builder builder;
+        TopoDS_Compound compound;
+        builder.MakeCompound(compound);
+        for (const TopoDS_Shape &child : children) { builder.Add(compound, child); }
+        double add_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Each child added as soon as it is made (the pattern of demo_bezier_surface_rational)
+        start = chrono::steady_clock::now();
+        TopoDS_Compound direct_compound;
+        builder.MakeCompound(direct_compound);
+        for (size_t i = 0; i < number_of_children; ++i) { builder.Add(direct_compound, make_child(prototype, i)); }
+        double direct_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        bool is_match = count_children(compound) == number_of_children &&
+                        count_children(direct_compound) == number_of_children;
+        all_match = all_match && is_match;
+        cout << setw(10) << number_of_children << setw(16) << make_time << setw(16) << add_time << setw(16)
+             << direct_time << setw(14) << 1e6 * add_time / double(number_of_children) << setw(10)
+             << (is_match ? "yes" : "NO") << endl;
+
+    }
+
+    // The compounds must hold every child
+    if (!all_match) {
+        cerr << "\nA compound does not have the expected number of children" << endl;
+        return 1;
+    }
+
+
+    return 0;
+
+
+}
@@ -0,0 +1,166 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the structure of arrays control net against the OpenCascade pole and weight arrays
+//  Usage: benchmark_control_net [net_size] (a net of net_size x net_size poles)
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+
+// Include the shared demo library
+#include "control_net.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Print one row of the table (the throughput counts the bytes of the poles and weights read or written)
+void print_row(const string &name, double milliseconds, double megabytes) {
+
+    cout << setw(44) << name << setw(12) << milliseconds << setw(12) << megabytes / max(milliseconds, 1e-6) << endl;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    int n = argc > 1 ? atoi(argv[1]) : 1000;
+    double megabytes = 4.0 * sizeof(double) * double(n) * double(n) / 1e6;
+
+    cout << "\n\nControl net of " << n << " x " << n << " rational poles (times in milliseconds, throughput in GB/s)"
+         << endl;
+    cout << setw(44) << "Operation" << setw(12) << "Time" << setw(12) << "GB/s" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Fill the poles and weights
+    // -------------------------------------------------------------------------------------------------------------- //
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    TColgp_Array2OfPnt P(1, n, 1, n);
+    TColStd_Array2OfReal W(1, n, 1, n);
+    for (int i = 1; i <= n; ++i) {
+        for (int j = 1; j <= n; ++j) {
+            P(i, j) = gp_Pnt(double(i), double(j), double(i * j % 7));
+            W(i, j) = 1.0 + double((i + j) % 3);
+        }
+    }
+    print_row("fill TColgp_Array2OfPnt + weights",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+
+    start = chrono::steady_clock::now();
+    ControlNet net(n, n, true);
+    double *x = net.x(), *y = net.y(), *z = net.z(), *w = net.w();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            size_t k = size_t(i) * size_t(n) + size_t(j);
+            x[k] = double(i + 1);
+            y[k] = double(j + 1);
+            z[k] = double((i + 1) * (j + 1) % 7);
+            w[k] = 1.0 + double((i + j + 2) % 3);
+        }
+    }
+    print_row("fill ControlNet",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Conversions
+    // -------------------------------------------------------------------------------------------------------------- //
+    start = chrono::steady_clock::now();
+    ControlNet copied_net(P, W);
+    print_row("TColgp arrays -> ControlNet (bulk copy)",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+
+    start = chrono::steady_clock::now();
+    TColgp_Array2OfPnt copied_poles = net.poles_2d();
+    print_row("ControlNet -> TColgp_Array2OfPnt (bulk copy)",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), 0.75 * megabytes);
+
+    start = chrono::steady_clock::now();
+    TColStd_Array2OfReal weight_view = net.view_2d(3);
+    print_row("ControlNet -> TColStd_Array2OfReal (view)",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), 0.25 * megabytes);
+    bool consistent = copied_poles(n, n).Distance(P(n, n)) == 0.0 && weight_view(n, n) == W(n, n) &&
+                      copied_net.pole(n - 1, n - 1).Distance(P(n, n)) == 0.0;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Streaming kernel: centroid of the poles weighted by their weights
+    // -------------------------------------------------------------------------------------------------------------- //
+    start = chrono::steady_clock::now();
+    double sx = 0.0, sy = 0.0, sz = 0.0, sw = 0.0;
+    for (int i = 1; i <= n; ++i) {
+        for (int j = 1; j <= n; ++j) {
+            const gp_Pnt &point = P(i, j);
+            double weight = W(i, j);
+            sx += weight * point.X();
+            sy += weight * point.Y();
+            sz += weight * point.Z();
+            sw += weight;
+        }
+    }
+    print_row("weighted centroid, TColgp arrays",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+    gp_Pnt array_centroid(sx / sw, sy / sw, sz / sw);
+
+    start = chrono::steady_clock::now();
+    sx = sy = sz = sw = 0.0;
+    for (size_t k = 0; k < size_t(net.size()); ++k) {
+        sx += w[k] * x[k];
+        sy += w[k] * y[k];
+        sz += w[k] * z[k];
+        sw += w[k];
+    }
+    print_row("weighted centroid, ControlNet",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+    gp_Pnt net_centroid(sx / sw, sy / sw, sz / sw);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Surface built from the net (pole copy plus weight view)
+    // -------------------------------------------------------------------------------------------------------------- //
+    int degree = 3;
+    TColStd_Array1OfReal knots(0, n - degree);
+    TColStd_Array1OfInteger mults(0, n - degree);
+    for (int i = 0; i <= n - degree; ++i) {
+        knots(i) = double(i) / double(n - degree);
+        mults(i) = (i == 0 || i == n - degree) ? degree + 1 : 1;
+    }
+    start = chrono::steady_clock::now();
+    Handle(Geom_BSplineSurface) surface = new Geom_BSplineSurface(net.poles_2d(), net.view_2d(3), knots, knots, mults,
+                                                                  mults, degree, degree);
+    print_row("Geom_BSplineSurface from ControlNet",
+              chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(), megabytes);
+
+    cout << "\nConversions consistent with the OpenCascade arrays: " << (consistent ? "yes" : "no") << endl;
+    cout << "Distance between the centroids: " << scientific << array_centroid.Distance(net_centroid) << endl;
+    cout << "Poles of the surface: " << surface->NbUPoles() << " x " << surface->NbVPoles() << endl;
+
+
+    return 0;
+
+
+}
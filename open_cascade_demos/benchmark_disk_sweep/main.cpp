@@ -0,0 +1,86 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of a design study of the perforated disk of demo_perforated_disk
+//  The variants are evaluated with one incremental model (see perforated_disk_model.h) and from scratch
+//  Usage: benchmark_disk_sweep
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Face.hxx>
+
+
+// Include the shared demo library
+#include "perforated_disk_model.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Print the result of a sweep
+// ------------------------------------------------------------------------------------------------------------------ //
+void print_sweep(const string &name, const DiskSweepResult &result) {
+
+    const PerforatedDiskModelStats &stats = result.model_stats;
+    cout << setw(14) << name << setw(10) << result.number_of_variants << setw(8) << result.number_of_valid_variants
+         << setw(12) << 1000.0 * result.seconds << setw(14) << result.variants_per_second()
+         << setw(12) << stats.number_of_boundary_builds << setw(12) << stats.number_of_prototype_builds
+         << setw(12) << stats.number_of_locations << setw(14) << stats.number_of_hole_wires << endl;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Variants of the disk (the hole radius changes fastest, so that consecutive variants share the hole locations)
+    // -------------------------------------------------------------------------------------------------------------- //
+    vector<PerforatedDiskParameters> variants;
+    for (int number_of_holes = 10; number_of_holes <= 100; number_of_holes += 5) {
+        for (int i = 0; i <= 10; ++i) {
+            for (int j = 0; j <= 10; ++j) {
+                PerforatedDiskParameters parameters;
+                parameters.number_of_holes = number_of_holes;
+                parameters.start_angle = 0.0;
+                parameters.ring_radius = 1.3 + 0.04 * i;
+                parameters.hole_radius = 0.02 + 0.01 * j;
+                variants.push_back(parameters);
+            }
+        }
+    }
+
+    cout << "\n\nSweep over the number of holes, the ring radius and the hole radius (time in milliseconds)" << endl;
+    cout << setw(14) << "Model" << setw(10) << "Variants" << setw(8) << "Valid" << setw(12) << "Time"
+         << setw(14) << "Variants/s" << setw(12) << "Boundaries" << setw(12) << "Prototypes"
+         << setw(12) << "Locations" << setw(14) << "Hole wires" << endl;
+    cout.precision(1);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Evaluate the variants from scratch and with the incremental model
+    // -------------------------------------------------------------------------------------------------------------- //
+    DiskSweepResult from_scratch = sweep_perforated_disk(variants, false);
+    print_sweep("from scratch", from_scratch);
+    DiskSweepResult incremental = sweep_perforated_disk(variants, true);
+    print_sweep("incremental", incremental);
+    cout << "Speed-up: " << incremental.variants_per_second() / from_scratch.variants_per_second() << endl;
+
+
+    return 0;
+
+
+}
@@ -0,0 +1,134 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the classification of points in perforated faces with an increasing number of holes
+//  The index of face_classifier_index.h is compared with BRepClass_FaceClassifier on a subset of the points
+//  Usage: benchmark_face_classifier [number_of_points]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepClass_FaceClassifier.hxx>
+#include <Precision.hxx>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+#include "perforated_face_builder.h"
+#include "face_classifier_index.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Annulus between the circles of radius 1 and 2 perforated by concentric rings of holes
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_perforated_annulus(int number_of_holes) {
+
+    // The inner circle of the annulus is one more hole
+    HolePattern hole_pattern;
+    HoleDescriptor inner_circle;
+    inner_circle.radius = 1.0;
+    hole_pattern.add_hole(inner_circle);
+
+    // Rings of holes with a pitch of about four hole radii (the area of the annulus is 3*pi)
+    double hole_radius = sqrt(3.0 * M_PI / number_of_holes) / 4.0;
+    double pitch = 4.0 * hole_radius;
+    for (double ring_radius = 1.0 + pitch / 2.0; ring_radius < 2.0 - pitch / 2.0; ring_radius += pitch) {
+        hole_pattern.add_circular_pattern(hole_radius, 0.0, 0.0, ring_radius, int(2.0 * M_PI * ring_radius / pitch));
+    }
+
+    gp_Ax2 axes(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+    TopoDS_Wire outer_wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 2)));
+    return make_perforated_face(gp_Pln(), outer_wire, hole_pattern.holes().data(), hole_pattern.size());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    size_t number_of_points = argc > 1 ? size_t(atol(argv[1])) : 1000000;
+    const size_t number_of_exact_points = 200;
+
+    // Random points in a square slightly larger than the disk (the same points for all the faces)
+    mt19937 generator(1);
+    uniform_real_distribution<double> distribution(-2.1, 2.1);
+    vector<gp_Pnt2d> points(number_of_points);
+    for (gp_Pnt2d &point : points) { point.SetCoord(distribution(generator), distribution(generator)); }
+
+    cout << "\n\nClassification of " << number_of_points << " points (times in milliseconds, the exact classifier "
+         << "is timed on " << number_of_exact_points << " points and extrapolated)" << endl;
+    cout << setw(10) << "Holes" << setw(12) << "Build" << setw(14) << "One thread" << setw(14) << "All threads"
+         << setw(14) << "Exact" << setw(16) << "Points/s" << setw(10) << "Exact %" << setw(10) << "Match" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Classify the points with the index (single thread and all threads) and compare with the exact classifier
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (int number_of_holes : {1000, 10000, 100000}) {
+
+        TopoDS_Face face = make_perforated_annulus(number_of_holes);
+        FaceClassifierIndex index(face);
+        double build = 1000.0 * index.build_seconds();
+
+        vector<TopAbs_State> states;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        index.classify(points, states, 1);
+        double one_thread = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        index.classify(points, states);
+        double all_threads = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Exact classification of the first points
+        size_t number_of_matches = 0;
+        size_t number_of_checked_points = min(number_of_exact_points, points.size());
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < number_of_checked_points; ++i) {
+            BRepClass_FaceClassifier classifier(face, points[i], Precision::Confusion());
+            if (classifier.State() == states[i]) { number_of_matches++; }
+        }
+        double exact = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        exact *= double(points.size()) / max(number_of_checked_points, size_t(1));
+
+        // The index was queried twice for every point
+        double exact_percentage = 50.0 * index.number_of_exact_queries() / max(points.size(), size_t(1));
+        cout << setw(10) << number_of_holes << setw(12) << build << setw(14) << one_thread << setw(14) << all_threads
+             << setw(14) << exact << setw(16) << setprecision(0) << points.size() / (all_threads / 1000.0)
+             << setprecision(3) << setw(10) << exact_percentage
+             << setw(10) << (number_of_matches == number_of_checked_points ? "yes" : "NO") << endl;
+
+    }
+
+
+    return 0;
+
+
+}
@@ -0,0 +1,133 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the glTF export with shared-geometry instancing on a bladed disk with an increasing number of blades
+//  Usage: benchmark_glb_export
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Compound.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+
+
+// Include the shared demo library
+#include "demo_models.h"
+#include "mesh_exporter.h"
+#include "gltf_exporter.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Bladed disk: copies of one blade rotated around the Z axis
+// The instanced blades share the TShape of the blade, the copied blades have their own geometry
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Shape make_bladed_disk(int number_of_blades, bool instanced) {
+
+    TopoDS_Shape blade = BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(1.0, 0.0, 0.0), gp::DZ()), 0.05, 0.5).Shape();
+    TopoDS_Compound bladed_disk;
+    BRep_Builder builder;
+    builder.MakeCompound(bladed_disk);
+    for (int i = 0; i < number_of_blades; ++i) {
+        gp_Trsf rotation;
+        rotation.SetRotation(gp::OZ(), 2 * M_PI * i / number_of_blades);
+        if (instanced) { builder.Add(bladed_disk, blade.Moved(TopLoc_Location(rotation))); }
+        else { builder.Add(bladed_disk, BRepBuilderAPI_Transform(blade, rotation, Standard_True).Shape()); }
+    }
+    return bladed_disk;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    string relative_path = "../output/";
+    mkdir(relative_path.c_str(), 0777);
+    int number_of_failures = 0;
+
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Instanced and copied blades
+    // -------------------------------------------------------------------------------------------------------------- //
+    cout << "\n\nBladed disk exported to glTF (mesh and write times in milliseconds, sizes in kilobytes)" << endl;
+    cout << setw(10) << "Blades" << setw(12) << "Blades are" << setw(10) << "Meshes" << setw(12) << "Instances"
+         << setw(12) << "Mesh" << setw(12) << "Write" << setw(12) << "glb [kB]" << setw(12) << "STL [kB]" << endl;
+
+    for (int number_of_blades : {10, 100, 1000}) {
+        for (bool instanced : {false, true}) {
+
+            TopoDS_Shape bladed_disk = make_bladed_disk(number_of_blades, instanced);
+            string model_name = "bladed_disk_" + to_string(number_of_blades) + (instanced ? "_instanced" : "_copied");
+
+            MeshExportStats stats = mesh_shape(bladed_disk);
+            GlbInstanceStats instance_stats;
+            if (!write_glb_file(relative_path + model_name + ".glb", bladed_disk, stats, &instance_stats)) {
+                number_of_failures++;
+            }
+            double write_seconds = stats.write_seconds;
+            size_t glb_bytes = stats.number_of_bytes;
+            if (!write_stl_file(relative_path + model_name + ".stl", bladed_disk, stats)) { number_of_failures++; }
+
+            cout << setw(10) << number_of_blades << setw(12) << (instanced ? "instanced" : "copied")
+                 << setw(10) << instance_stats.number_of_meshes << setw(12) << instance_stats.number_of_instances
+                 << setw(12) << 1e3 * stats.mesh_seconds << setw(12) << 1e3 * write_seconds
+                 << setw(12) << glb_bytes / 1024.0 << setw(12) << stats.number_of_bytes / 1024.0 << endl;
+
+        }
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Instancing found in the models of the demonstration scripts
+    // -------------------------------------------------------------------------------------------------------------- //
+    vector<DemoModel> models = load_demo_models();
+    cout << "\n\nInstancing in the demo models" << endl;
+    cout << setw(40) << "Demo" << setw(10) << "Meshes" << setw(12) << "Instances" << setw(12) << "Triangles"
+         << setw(12) << "Drawn" << setw(12) << "glb [kB]" << endl;
+
+    for (const DemoModel &model : models) {
+        MeshExportStats stats = mesh_shape(model.model_object);
+        GlbInstanceStats instance_stats;
+        if (!write_glb_file(relative_path + model.demo_name + ".glb", model.model_object, stats, &instance_stats)) {
+            number_of_failures++;
+        }
+        cout << setw(40) << model.demo_name << setw(10) << instance_stats.number_of_meshes
+             << setw(12) << instance_stats.number_of_instances << setw(12) << instance_stats.number_of_triangles
+             << setw(12) << instance_stats.number_of_drawn_triangles << setw(12) << stats.number_of_bytes / 1024.0
+             << endl;
+    }
+
+    cout << "\n\nFailed writes: " << number_of_failures << endl;
+
+
+    return number_of_failures == 0 ? 0 : 1;
+
+
+}
@@ -0,0 +1,314 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the construction and of the validation of perforated disks with an increasing number of holes
+//  The construction of the holes one by one is compared with the pattern of located instances (see hole_pattern.h)
+//  and with the bulk face builder (see perforated_face_builder.h)
+//  Usage: benchmark_hole_pattern
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax1.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+#include <TopExp_Explorer.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+
+
+// Include the shared demo library
+#include "brep_cache.h"
+#include "hole_pattern.h"
+#include "hole_validator.h"
+#include "perforated_face_builder.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Annulus between the circles of radius 1 and 2 (the holes are added afterwards)
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_annulus() {
+
+    BRep_Builder builder;
+    TopoDS_Face face = BRepBuilderAPI_MakeFace(gp_Pln());
+    gp_Ax2 axes(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+    builder.Add(face, BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 2))).Wire());
+    builder.Add(face, BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 1))).Wire().Reversed());
+    return face;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Holes built one by one, as in the original demo_perforated_disk
+// ------------------------------------------------------------------------------------------------------------------ //
+void add_holes_one_by_one(TopoDS_Face &face, int number_of_holes, double hole_radius) {
+
+    BRep_Builder builder;
+    for (int i = 0; i < number_of_holes; ++i) {
+        gp_Ax2 axes(gp_Pnt(1.5, 0, 0), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+        TopoDS_Wire wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, hole_radius)));
+        gp_Trsf rotation;
+        rotation.SetRotation(gp_Ax1(gp_Pnt(), gp_Dir(0, 0, 1)), 2. * M_PI * i / number_of_holes);
+        wire.Move(rotation);
+        builder.Add(face, wire.Reversed());
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Number of distinct edge TShapes of a shape (the located copies of an edge share its TShape)
+// ------------------------------------------------------------------------------------------------------------------ //
+size_t count_distinct_edges(const TopoDS_Shape &shape) {
+
+    set<const void *> tshapes;
+    for (TopExp_Explorer explorer(shape, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+        tshapes.insert(explorer.Current().TShape().get());
+    }
+    return tshapes.size();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Size of a file in kilobytes
+// ------------------------------------------------------------------------------------------------------------------ //
+double file_size_kilobytes(const string &file_name) {
+
+    struct stat file_status;
+    if (stat(file_name.c_str(), &file_status) != 0) { return 0.0; }
+    return file_status.st_size / 1024.0;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Concentric rings of holes filling the annulus, plus a few misplaced holes (overlapping or crossing the boundaries)
+// ------------------------------------------------------------------------------------------------------------------ //
+HolePattern make_ring_pattern(int number_of_holes, int number_of_misplaced_holes) {
+
+    // Rings of holes with a pitch of about four hole radii in the radial and circumferential directions
+    // The area of the annulus between the radii 1 and 2 is 3*pi, and each hole takes about (4*r)^2
+    double hole_radius = sqrt(3.0 * M_PI / number_of_holes) / 4.0;
+    double pitch = 4.0 * hole_radius;
+    HolePattern pattern;
+    pattern.reserve(number_of_holes + number_of_misplaced_holes);
+    for (double ring_radius = 1.0 + pitch / 2.0; ring_radius < 2.0 - pitch / 2.0; ring_radius += pitch) {
+        int holes_in_ring = int(2.0 * M_PI * ring_radius / pitch);
+        pattern.add_circular_pattern(hole_radius, 0.0, 0.0, ring_radius, holes_in_ring);
+    }
+
+    // Larger holes at random positions in the annulus, which may touch the boundaries or the other holes
+    mt19937 generator(1);
+    uniform_real_distribution<double> distribution(0.0, 1.0);
+    for (int i = 0; i < number_of_misplaced_holes; ++i) {
+        double radius = 1.0 + distribution(generator);
+        double angle = 2.0 * M_PI * distribution(generator);
+        HoleDescriptor hole;
+        hole.x = radius * cos(angle);
+        hole.y = radius * sin(angle);
+        hole.radius = 2.0 * hole_radius;
+        pattern.add_hole(hole);
+    }
+    return pattern;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Reference validation that compares every pair of holes (only the number of problems is computed)
+// ------------------------------------------------------------------------------------------------------------------ //
+void validate_brute_force(const vector<HoleDescriptor> &holes, const AnnularRegion &region, size_t &number_of_overlaps,
+                          size_t &number_of_boundary_problems) {
+
+    number_of_overlaps = 0;
+    number_of_boundary_problems = 0;
+    for (size_t i = 0; i < holes.size(); ++i) {
+        double distance = hypot(holes[i].x - region.x_center, holes[i].y - region.y_center);
+        if (distance - holes[i].radius < region.inner_radius) { number_of_boundary_problems++; }
+        if (distance + holes[i].radius > region.outer_radius) { number_of_boundary_problems++; }
+        for (size_t j = i + 1; j < holes.size(); ++j) {
+            double gap = hypot(holes[i].x - holes[j].x, holes[i].y - holes[j].y) - holes[i].radius - holes[j].radius;
+            if (gap < 0.0) { number_of_overlaps++; }
+        }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    string relative_path = "../output/";
+
+    cout << "\n\nConstruction of a perforated disk (times in milliseconds, BRep file size in kilobytes)" << endl;
+    cout << setw(10) << "Holes" << setw(14) << "Method" << setw(12) << "Build" << setw(12) << "Edges"
+         << setw(14) << "BRep [kB]" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Compare the construction hole by hole with the pattern of located instances
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (int number_of_holes : {100, 1000, 10000, 100000}) {
+
+        // Keep the holes of the circular pattern apart from each other
+        double hole_radius = min(0.1, 0.4 * M_PI * 1.5 / number_of_holes);
+
+        for (bool use_pattern : {false, true}) {
+
+            TopoDS_Face face = make_annulus();
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            if (use_pattern) {
+                HolePattern hole_pattern;
+                hole_pattern.add_circular_pattern(hole_radius, 0.0, 0.0, 1.5, number_of_holes);
+                hole_pattern.add_to_face(face);
+            }
+            else { add_holes_one_by_one(face, number_of_holes, hole_radius); }
+            double build = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            string model_name = "perforated_disk_" + to_string(number_of_holes) + (use_pattern ? "_pattern" : "");
+            write_brep_file(relative_path, model_name, face);
+
+            cout << setw(10) << number_of_holes << setw(14) << (use_pattern ? "pattern" : "one by one")
+                 << setw(12) << build << setw(12) << count_distinct_edges(face)
+                 << setw(14) << file_size_kilobytes(relative_path + model_name + BREP_CACHE_EXTENSION) << endl;
+
+        }
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Create the located hole wires of the pattern with one thread and with all the threads (see parallel_build.h)
+    // -------------------------------------------------------------------------------------------------------------- //
+    cout << "\n\nConstruction of a perforated disk with located holes (times in milliseconds)" << endl;
+    cout << setw(10) << "Holes" << setw(14) << "One thread" << setw(14) << "All threads" << setw(12) << "Speed-up"
+         << endl;
+
+    for (int number_of_holes : {100000, 1000000}) {
+
+        double hole_radius = min(0.1, 0.4 * M_PI * 1.5 / number_of_holes);
+        HolePattern hole_pattern;
+        hole_pattern.add_circular_pattern(hole_radius, 0.0, 0.0, 1.5, number_of_holes);
+
+        double times[2];
+        for (int k = 0; k < 2; ++k) {
+            TopoDS_Face face = make_annulus();
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            hole_pattern.add_to_face(face, k == 0 ? 1 : 0);
+            times[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+        cout << setw(10) << number_of_holes << setw(14) << times[0] << setw(14) << times[1]
+             << setw(12) << times[0] / times[1] << endl;
+
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Compare the construction hole by hole with the bulk builder, which gives every hole its own edge as well
+    // -------------------------------------------------------------------------------------------------------------- //
+    cout << "\n\nConstruction of a perforated disk with one edge per hole (times in milliseconds)" << endl;
+    cout << setw(10) << "Holes" << setw(14) << "One by one" << setw(12) << "Bulk" << setw(12) << "Threads"
+         << setw(12) << "Speed-up" << endl;
+
+    for (int number_of_holes : {10000, 100000, 1000000}) {
+
+        double hole_radius = min(0.1, 0.4 * M_PI * 1.5 / number_of_holes);
+
+        // Original construction with the BRepBuilderAPI algorithms
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        TopoDS_Face face = make_annulus();
+        add_holes_one_by_one(face, number_of_holes, hole_radius);
+        double one_by_one = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Bulk construction from the array of descriptors (the inner circle of the annulus is one more hole)
+        start = chrono::steady_clock::now();
+        HolePattern hole_pattern;
+        hole_pattern.reserve(number_of_holes + 1);
+        HoleDescriptor inner_circle;
+        inner_circle.radius = 1.0;
+        hole_pattern.add_hole(inner_circle);
+        hole_pattern.add_circular_pattern(hole_radius, 0.0, 0.0, 1.5, number_of_holes);
+        gp_Ax2 axes(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+        TopoDS_Wire outer_wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 2)));
+        PerforatedFaceStats stats;
+        TopoDS_Face bulk_face = make_perforated_face(gp_Pln(), outer_wire, hole_pattern.holes().data(),
+                                                     hole_pattern.size(), 0, &stats);
+        double bulk = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << setw(10) << number_of_holes << setw(14) << one_by_one << setw(12) << bulk
+             << setw(12) << stats.number_of_threads << setw(12) << one_by_one / bulk << endl;
+
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Validate the holes with the uniform grid and compare with the brute force check (only for the smaller sizes)
+    // -------------------------------------------------------------------------------------------------------------- //
+    cout << "\n\nValidation of the holes (times in milliseconds, the brute force check is skipped above 10000 holes)"
+         << endl;
+    cout << setw(10) << "Holes" << setw(12) << "Grid" << setw(14) << "Brute force" << setw(12) << "Overlaps"
+         << setw(12) << "Boundary" << setw(10) << "Match" << endl;
+
+    AnnularRegion annulus;
+    annulus.inner_radius = 1.0;
+    annulus.outer_radius = 2.0;
+    for (int number_of_holes : {100, 10000, 1000000}) {
+
+        HolePattern hole_pattern = make_ring_pattern(number_of_holes, 10);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        HoleValidationReport report = hole_pattern.validate(annulus);
+        double grid = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << setw(10) << hole_pattern.size() << setw(12) << grid;
+        if (number_of_holes <= 10000) {
+            size_t number_of_overlaps, number_of_boundary_problems;
+            start = chrono::steady_clock::now();
+            validate_brute_force(hole_pattern.holes(), annulus, number_of_overlaps, number_of_boundary_problems);
+            double brute_force = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            bool is_match = number_of_overlaps == report.number_of_overlaps &&
+                            number_of_boundary_problems == report.number_of_boundary_problems;
+            cout << setw(14) << brute_force << setw(12) << report.number_of_overlaps
+                 << setw(12) << report.number_of_boundary_problems << setw(10) << (is_match ? "yes" : "NO") << endl;
+        }
+        else {
+            cout << setw(14) << "-" << setw(12) << report.number_of_overlaps
+                 << setw(12) << report.number_of_boundary_problems << setw(10) << "-" << endl;
+        }
+
+    }
+
+
+    return 0;
+
+
+}
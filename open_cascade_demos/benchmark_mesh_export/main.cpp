@@ -0,0 +1,108 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the tessellation and of the STL/OBJ export for every demo model at several deflections
+//  Usage: benchmark_mesh_export
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+#include <BRepTools.hxx>
+
+
+// Include the shared demo library
+#include "demo_models.h"
+#include "mesh_exporter.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Mesh the shape from scratch (the triangulations of previous runs are discarded first)
+// ------------------------------------------------------------------------------------------------------------------ //
+MeshExportStats mesh_from_scratch(const TopoDS_Shape &shape, double deflection, bool parallel) {
+
+    BRepTools::Clean(shape);
+    MeshExportOptions options;
+    options.linear_deflection = deflection;
+    options.parallel = parallel;
+    return mesh_shape(shape, options);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Load the models of the demonstration scripts
+    // -------------------------------------------------------------------------------------------------------------- //
+    vector<DemoModel> models = load_demo_models();
+    if (models.empty()) {
+        cout << "No demo models found. Run the demonstration scripts first." << endl;
+        return 1;
+    }
+
+    // Relative deflections (fraction of the bounding box diagonal)
+    vector<double> deflections = {1e-2, 3e-3, 1e-3, 3e-4};
+
+    string relative_path = "../output/";
+    mkdir(relative_path.c_str(), 0777);
+    int number_of_failures = 0;
+
+    cout << "\n\nTessellation and mesh export of every demo model" << endl;
+    cout << setw(40) << "Demo" << setw(12) << "Deflection" << setw(12) << "Triangles"
+         << setw(12) << "Serial [s]" << setw(14) << "Parallel [s]" << setw(16) << "Triangles/s"
+         << setw(12) << "STL [MB/s]" << setw(12) << "OBJ [MB/s]" << endl;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Mesh every model at every deflection, serially and in parallel, and write both formats
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (const DemoModel &model : models) {
+        for (double deflection : deflections) {
+
+            MeshExportStats serial = mesh_from_scratch(model.model_object, deflection, false);
+            MeshExportStats parallel = mesh_from_scratch(model.model_object, deflection, true);
+
+            MeshExportStats stl_stats, obj_stats;
+            if (!write_stl_file(relative_path + model.demo_name + ".stl", model.model_object, stl_stats)) {
+                number_of_failures++;
+            }
+            if (!write_obj_file(relative_path + model.demo_name + ".obj", model.model_object, obj_stats)) {
+                number_of_failures++;
+            }
+            auto megabytes_per_second = [](const MeshExportStats &stats) {
+                return stats.write_seconds > 0.0 ? stats.number_of_bytes / stats.write_seconds / 1e6 : 0.0;
+            };
+
+            cout << setw(40) << model.demo_name << setw(12) << setprecision(1) << scientific << deflection
+                 << setw(12) << parallel.number_of_triangles << fixed << setprecision(4)
+                 << setw(12) << serial.mesh_seconds << setw(14) << parallel.mesh_seconds
+                 << setw(16) << setprecision(0) << parallel.triangles_per_second() << setprecision(1)
+                 << setw(12) << megabytes_per_second(stl_stats) << setw(12) << megabytes_per_second(obj_stats) << endl;
+
+        }
+    }
+
+    cout << "\n\nFailed writes: " << number_of_failures << endl;
+
+
+    return number_of_failures == 0 ? 0 : 1;
+
+
+}
@@ -0,0 +1,159 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the sample writer against the ofstream output of demo_evolution_law
+//  Two columns of samples (parameter and value) are written to temporary files in the current directory
+//  The CSV file of the sample writer is read back with strtod, and the program fails (exit code 1) if any value differs
+//  Usage: benchmark_sample_writer [number_of_samples]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+// Include the shared demo library
+#include "sample_writer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Print one row of the table
+void print_row(const string &name, double seconds, size_t number_of_bytes) {
+
+    double megabytes = double(number_of_bytes) / 1e6;
+    cout << setw(42) << name << setw(12) << 1000.0 * seconds << setw(12) << megabytes << setw(12)
+         << megabytes / max(seconds, 1e-9) << endl;
+
+}
+
+
+// Read a CSV file of two columns back with strtod and count the values that differ from the samples (or are missing)
+size_t count_csv_mismatches(const string &file_name, const vector<double> &u, const vector<double> &f) {
+
+    ifstream file(file_name, ios::binary);
+    string text((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const char *position = text.c_str();
+    size_t number_of_mismatches = 0;
+    for (size_t i = 0; i < u.size(); ++i) {
+        for (const double *column : {u.data(), f.data()}) {
+            char *end = nullptr;
+            double value = strtod(position, &end);
+            if (end == position) { return number_of_mismatches + 2 * (u.size() - i); }
+            if (value != column[i]) { number_of_mismatches++; }
+            position = end;
+            while (*position == ',' || *position == ' ' || *position == '\n') { position++; }
+        }
+    }
+    return number_of_mismatches;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    // At least two samples, so that the parameter step 1 / (number_of_samples - 1) is finite
+    long number_of_samples_argument = argc > 1 ? atol(argv[1]) : 1000000;
+    if (number_of_samples_argument < 2) {
+        cerr << "The number of samples must be at least 2 (got " << number_of_samples_argument << ")" << endl;
+        return 1;
+    }
+    size_t number_of_samples = size_t(number_of_samples_argument);
+    string file_name = "benchmark_sample_writer.tmp";
+
+    // Samples of a smooth law, as in demo_evolution_law
+    vector<double> u(number_of_samples), f(number_of_samples);
+    for (size_t i = 0; i < number_of_samples; ++i) {
+        u[i] = double(i) / double(number_of_samples - 1);
+        f[i] = 1.0 + 2.0 * u[i] * (1.0 - u[i]) * sin(3.0 * u[i]);
+    }
+
+    cout << "\n\nWriting " << number_of_samples << " samples (times in milliseconds, sizes in MB)" << endl;
+    cout << setw(42) << "Writer" << setw(12) << "Time" << setw(12) << "Size" << setw(12) << "MB/s" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Current path of demo_evolution_law: ofstream with 8 fixed decimals and endl (one flush per row)
+    // -------------------------------------------------------------------------------------------------------------- //
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    {
+        ofstream file(file_name);
+        file.precision(8);
+        file.setf(ios::fixed);
+        for (size_t i = 0; i < number_of_samples; ++i) { file << u[i] << ", " << f[i] << endl; }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        print_row("ofstream, fixed 8 decimals, endl", seconds, size_t(file.tellp()));
+    }
+
+    // Same formatting without the flush of every row
+    start = chrono::steady_clock::now();
+    {
+        ofstream file(file_name);
+        file.precision(8);
+        file.setf(ios::fixed);
+        for (size_t i = 0; i < number_of_samples; ++i) { file << u[i] << ", " << f[i] << '\n'; }
+        file.flush();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        print_row("ofstream, fixed 8 decimals, '\\n'", seconds, size_t(file.tellp()));
+    }
+
+    // Full precision through ofstream, for comparison with the shortest round-trip CSV
+    start = chrono::steady_clock::now();
+    {
+        ofstream file(file_name);
+        file.precision(17);
+        for (size_t i = 0; i < number_of_samples; ++i) { file << u[i] << ", " << f[i] << '\n'; }
+        file.flush();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        print_row("ofstream, 17 digits, '\\n'", seconds, size_t(file.tellp()));
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Sample writer in each format
+    // -------------------------------------------------------------------------------------------------------------- //
+    size_t number_of_mismatches = 0;
+    bool all_written = true;
+    for (const char *format_name : {"csv", "npy", "raw"}) {
+        string format = format_name;
+        size_t number_of_bytes = 0;
+        start = chrono::steady_clock::now();
+        bool is_written = write_samples(file_name, format, {u.data(), f.data()}, number_of_samples, &number_of_bytes);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (!is_written) { cerr << "Writing the " << format << " samples failed" << endl; }
+        all_written = all_written && is_written;
+        print_row("SampleWriter, " + format + (format == "csv" ? " (shortest round trip)" : ""), seconds,
+                  number_of_bytes);
+
+        // Every value of the CSV file must read back to the same double
+        if (format == "csv" && is_written) { number_of_mismatches = count_csv_mismatches(file_name, u, f); }
+    }
+
+    remove(file_name.c_str());
+
+    cout << "\nValues of the CSV file that do not read back exactly: " << number_of_mismatches << " of "
+         << 2 * number_of_samples << endl;
+    if (number_of_mismatches > 0 || !all_written) { return 1; }
+
+
+    return 0;
+
+
+}
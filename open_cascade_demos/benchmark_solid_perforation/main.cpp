@@ -0,0 +1,131 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the perforation of a disk by inner wires and by a boolean cut of cylinders
+//  Usage: benchmark_solid_perforation
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Shape.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepPrimAPI_MakePrism.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+#include "hole_validator.h"
+#include "solid_perforation.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Perforated solid built by adding the holes as inner wires of the face and extruding the face
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Shape make_solid_from_wires(const HolePattern &hole_pattern, double thickness) {
+
+    BRep_Builder builder;
+    TopoDS_Face face = BRepBuilderAPI_MakeFace(gp_Pln());
+    gp_Ax2 axes(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+    builder.Add(face, BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 2))).Wire());
+    builder.Add(face, BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, 1))).Wire().Reversed());
+    hole_pattern.add_to_face(face);
+    return BRepPrimAPI_MakePrism(face, gp_Vec(0.0, 0.0, thickness)).Shape();
+
+}
+
+
+// Volume of a shape
+double volume(const TopoDS_Shape &shape) {
+
+    if (shape.IsNull()) { return 0.0; }
+    GProp_GProps properties;
+    BRepGProp::VolumeProperties(shape, properties);
+    return properties.Mass();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    AnnularRegion annulus;
+    annulus.inner_radius = 1.0;
+    annulus.outer_radius = 2.0;
+    SolidPerforationOptions options;
+
+    cout << "\n\nPerforation of a disk of thickness " << options.thickness << " (times in milliseconds, the serial "
+         << "boolean cut is skipped above 1000 holes)" << endl;
+    cout << setw(10) << "Holes" << setw(12) << "Wires" << setw(14) << "Cut parallel" << setw(14) << "Cut serial"
+         << setw(10) << "Tools" << setw(14) << "Volume error" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Compare the insertion of inner wires with the boolean cut (in parallel and serial mode)
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (int number_of_holes : {10, 100, 1000, 10000}) {
+
+        // Keep the holes of the circular pattern apart from each other
+        double hole_radius = min(0.1, 0.4 * M_PI * 1.5 / number_of_holes);
+        HolePattern hole_pattern;
+        hole_pattern.add_circular_pattern(hole_radius, 0.0, 0.0, 1.5, number_of_holes);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        TopoDS_Shape wire_solid = make_solid_from_wires(hole_pattern, options.thickness);
+        double wires = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        SolidPerforationStats stats;
+        options.parallel = true;
+        start = chrono::steady_clock::now();
+        TopoDS_Shape cut_solid = make_perforated_solid(annulus, hole_pattern.holes(), options, &stats);
+        double cut_parallel = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        double cut_serial = 0.0;
+        if (number_of_holes <= 1000) {
+            options.parallel = false;
+            start = chrono::steady_clock::now();
+            make_perforated_solid(annulus, hole_pattern.holes(), options);
+            cut_serial = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+
+        // Both methods must give the same solid
+        double wire_volume = volume(wire_solid);
+        double volume_error = fabs(volume(cut_solid) - wire_volume) / wire_volume;
+        cout << setw(10) << number_of_holes << setw(12) << wires << setw(14) << cut_parallel;
+        if (number_of_holes <= 1000) { cout << setw(14) << cut_serial; }
+        else { cout << setw(14) << "-"; }
+        cout << setw(10) << stats.number_of_cut_tools << setw(14) << scientific << volume_error << fixed << endl;
+
+    }
+
+
+    return 0;
+
+
+}
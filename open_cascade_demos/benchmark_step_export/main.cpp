@@ -0,0 +1,294 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the STEP exporters of the shared demo library
+//  Usage: benchmark_step_export [number_of_disks] [max_number_of_threads]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+
+// Include OpenCascade libraries
+#include <gp_Pln.hxx>
+#include <gp_Circ.hxx>
+#include <TopoDS_Wire.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Compound.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <Geom_BezierCurve.hxx>
+#include <Geom_BezierSurface.hxx>
+#include <GeomFill_BezierCurves.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+#include "step_batch_exporter.h"
+#include "step_export_pipeline.h"
+#include "step_stream_writer.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Perforated disk of demo_perforated_disk (with a variable number of holes)
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_perforated_disk(int nCuts) {
+
+    BRep_Builder aBuilder;
+    gp_Pln planeXY;
+    TopoDS_Face aFace = BRepBuilderAPI_MakeFace(planeXY);
+    gp_Ax2 Ax2(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+    TopoDS_Wire wireIn = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(Ax2, 1)));
+    TopoDS_Wire wireOut = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(Ax2, 2)));
+    aBuilder.Add(aFace, wireOut);
+    aBuilder.Add(aFace, wireIn.Reversed());
+    for (int i = 1; i < nCuts; i++) {
+        gp_Ax2 Ax(gp_Pnt(1.5, 0, 0), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+        TopoDS_Wire wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(Ax, 0.1)));
+        gp_Trsf rot;
+        rot.SetRotation(gp_Ax1(gp_Pnt(), gp_Dir(0, 0, 1)), 2. * M_PI * i / (nCuts - 1.));
+        wire.Move(rot);
+        aBuilder.Add(aFace, wire.Reversed());
+    }
+    return aFace;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Coons patch of demo_coons_surface_4boundaries (with a variable height of the boundary curves)
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_coons_surface(double height) {
+
+    TColgp_Array1OfPnt P_south(1, 3);
+    P_south(1) = gp_Pnt(0.00, 0.0, 0.0);
+    P_south(2) = gp_Pnt(0.50, -0.2, height);
+    P_south(3) = gp_Pnt(1.00, 0.0, 0.0);
+    Handle(Geom_BezierCurve) bezier_south = new Geom_BezierCurve(P_south);
+
+    TColgp_Array1OfPnt P_north(1, 3);
+    P_north(1) = gp_Pnt(0.00, 1.0, 0.0);
+    P_north(2) = gp_Pnt(0.50, 0.8, height);
+    P_north(3) = gp_Pnt(1.00, 1.0, 0.0);
+    Handle(Geom_BezierCurve) bezier_north = new Geom_BezierCurve(P_north);
+
+    TColgp_Array1OfPnt P_west(1, 3);
+    P_west(1) = bezier_south->Pole(1);
+    P_west(2) = gp_Pnt(-0.20, 0.5, height);
+    P_west(3) = bezier_north->Pole(1);
+    Handle(Geom_BezierCurve) bezier_west = new Geom_BezierCurve(P_west);
+
+    TColgp_Array1OfPnt P_east(1, 3);
+    P_east(1) = bezier_south->Pole(bezier_south->NbPoles());
+    P_east(2) = gp_Pnt(1.20, 0.5, height);
+    P_east(3) = bezier_north->Pole(bezier_south->NbPoles());
+    Handle(Geom_BezierCurve) bezier_east = new Geom_BezierCurve(P_east);
+
+    GeomFill_BezierCurves makeBezierSurfGeo(bezier_west, bezier_south, bezier_east, bezier_north, GeomFill_CoonsStyle);
+    Handle(Geom_BezierSurface) BezierSurfGeo = makeBezierSurfGeo.Surface();
+    return BRepBuilderAPI_MakeFace(BezierSurfGeo, 0.);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read the whole content of a file
+// ------------------------------------------------------------------------------------------------------------------ //
+string read_file(const string &file_name) {
+
+    ifstream file(file_name, ios::binary);
+    return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Peak resident memory of the process in megabytes
+// ------------------------------------------------------------------------------------------------------------------ //
+double peak_memory_megabytes() {
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;      // ru_maxrss is given in kilobytes on Linux
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Create the list of jobs
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    // Read the size of the benchmark from the command line
+    int number_of_disks = argc > 1 ? atoi(argv[1]) : 1000;
+    int max_number_of_threads = resolve_number_of_threads(argc > 2 ? atoi(argv[2]) : 0);
+
+    // Create perforated disks with 10 to 40 holes
+    vector<StepExportJob> jobs(number_of_disks);
+    for (int i = 0; i < number_of_disks; ++i) {
+        jobs[i].model_name = "perforated_disk_" + to_string(i);
+        jobs[i].model_object = make_perforated_disk(10 + i % 31);
+    }
+
+    // All the files use the same time stamp so that the serial and parallel outputs can be compared byte by byte
+    string time_stamp = current_step_time_stamp();
+    cout << "\n\nExporting " << number_of_disks << " perforated disks" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Serial export with a new STEPControl_Writer per file (the original write_step_file of the demos)
+    // -------------------------------------------------------------------------------------------------------------- //
+    string cold_path = "../output/step_cold/";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (const StepExportJob &job : jobs) {
+        StepExporter step_exporter;
+        step_exporter.set_time_stamp(time_stamp);
+        step_exporter.write(cold_path, job.model_name, job.model_object);
+    }
+    double cold_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Serial export with a warm exporter
+    // -------------------------------------------------------------------------------------------------------------- //
+    string serial_path = "../output/step_serial/";
+    StepExporter step_exporter;
+    step_exporter.set_time_stamp(time_stamp);
+    start = chrono::steady_clock::now();
+    for (const StepExportJob &job : jobs) {
+        step_exporter.write(serial_path, job.model_name, job.model_object);
+    }
+    double serial_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << setw(30) << "Method" << setw(15) << "Threads" << setw(15) << "Time [s]" << setw(15) << "Files/s" << endl;
+    cout << setw(30) << "New writer per file" << setw(15) << 1 << setw(15) << cold_seconds
+         << setw(15) << number_of_disks / cold_seconds << endl;
+    cout << setw(30) << "Warm writer" << setw(15) << 1 << setw(15) << serial_seconds
+         << setw(15) << number_of_disks / serial_seconds << endl;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Parallel export with an increasing number of worker threads
+    // -------------------------------------------------------------------------------------------------------------- //
+    string parallel_path = "../output/step_parallel/";
+    for (int number_of_threads = 1; number_of_threads <= max_number_of_threads; number_of_threads *= 2) {
+        StepBatchResult result = write_step_batch(parallel_path, jobs, number_of_threads, time_stamp);
+        cout << setw(30) << "Parallel batch" << setw(15) << result.number_of_threads << setw(15)
+             << result.wall_seconds << setw(15) << number_of_disks / result.wall_seconds
+             << "   (speed-up " << serial_seconds / result.wall_seconds << ", failures "
+             << result.number_of_failures << ")" << endl;
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Check that the parallel output is byte-identical to the serial output
+    // -------------------------------------------------------------------------------------------------------------- //
+    int number_of_mismatches = 0;
+    for (const StepExportJob &job : jobs) {
+        string serial_file = read_file(serial_path + job.model_name + ".step");
+        string parallel_file = read_file(parallel_path + job.model_name + ".step");
+        if (serial_file.empty() || serial_file != parallel_file) { number_of_mismatches++; }
+    }
+    cout << "\n\nFiles that differ between the serial and the parallel export: " << number_of_mismatches << endl;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Parameter sweep of Coons patches: modelling followed by a blocking write
+    // -------------------------------------------------------------------------------------------------------------- //
+    int number_of_variants = number_of_disks;
+    string sweep_path = "../output/step_sweep/";
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < number_of_variants; ++i) {
+        TopoDS_Face coons_surface = make_coons_surface(1.0 * i / number_of_variants);
+        step_exporter.write(sweep_path, "coons_surface_" + to_string(i), coons_surface);
+    }
+    double blocking_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Parameter sweep of Coons patches: modelling overlapped with writing
+    // -------------------------------------------------------------------------------------------------------------- //
+    start = chrono::steady_clock::now();
+    StepExportPipeline pipeline(sweep_path, 32, max(max_number_of_threads - 1, 1));
+    for (int i = 0; i < number_of_variants; ++i) {
+        TopoDS_Face coons_surface = make_coons_surface(1.0 * i / number_of_variants);
+        pipeline.push("coons_surface_" + to_string(i), coons_surface);
+    }
+    pipeline.flush();
+    double pipeline_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    pipeline.join();
+
+    cout << "\n\nParameter sweep of " << number_of_variants << " Coons patches" << endl;
+    cout << setw(30) << "Blocking write [s]" << setw(15) << blocking_seconds << endl;
+    cout << setw(30) << "Pipeline [s]" << setw(15) << pipeline_seconds << endl;
+    pipeline.print_stats(cout);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Assembly of many disks: streamed export (first, so that the peak memory is not hidden by the next step)
+    // -------------------------------------------------------------------------------------------------------------- //
+    TopoDS_Compound assembly;
+    BRep_Builder assembly_builder;
+    assembly_builder.MakeCompound(assembly);
+    for (const StepExportJob &job : jobs) { assembly_builder.Add(assembly, job.model_object); }
+
+    string assembly_path = "../output/step_assembly/";
+    double memory_before = peak_memory_megabytes();
+    start = chrono::steady_clock::now();
+    StepStreamWriter stream_writer(assembly_path, "assembly_streamed", 2000);
+    stream_writer.add(assembly);
+    stream_writer.close();
+    double stream_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double stream_memory = peak_memory_megabytes() - memory_before;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Assembly of many disks: whole model in memory
+    // -------------------------------------------------------------------------------------------------------------- //
+    memory_before = peak_memory_megabytes();
+    start = chrono::steady_clock::now();
+    step_exporter.write(assembly_path, "assembly", assembly);
+    double whole_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double whole_memory = peak_memory_megabytes() - memory_before;
+
+    // Check that both files describe the same model
+    StepValidationReport report = validate_step_files(assembly_path + "assembly_streamed.step",
+                                                      assembly_path + "assembly.step");
+
+    cout << "\n\nAssembly of " << number_of_disks << " perforated disks" << endl;
+    cout << setw(30) << "Method" << setw(15) << "Time [s]" << setw(20) << "Peak growth [MB]" << endl;
+    cout << setw(30) << "Streamed" << setw(15) << stream_seconds << setw(20) << stream_memory << "   ("
+         << stream_writer.stats().number_of_chunks << " chunks, "
+         << stream_writer.stats().number_of_entities << " entities)" << endl;
+    cout << setw(30) << "Whole model" << setw(15) << whole_seconds << setw(20) << whole_memory << endl;
+    cout << "Streamed file equivalent to the reference: " << (report.is_equivalent ? "yes" : "no") << endl;
+
+
+    return number_of_mismatches == 0 && report.is_equivalent ? 0 : 1;
+
+
+}
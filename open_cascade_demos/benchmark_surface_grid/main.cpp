@@ -0,0 +1,208 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the evaluation of B-Spline and NURBS surfaces on dense grids of parameters
+//  The grid evaluator of surface_grid_evaluator.h is compared with Geom_BSplineSurface::D2 called at every point
+//  The program fails (exit code 1) if the relative error of a quantity exceeds MAX_RELATIVE_ERROR
+//  Usage: benchmark_surface_grid [grid_size] [number_of_threads]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+
+// Include the shared demo library
+#include "surface_grid_evaluator.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Largest error accepted on each quantity, relative to the largest magnitude of that quantity over the grid (the
+// evaluator and D2 sum the same terms in another order, so the difference is a small multiple of the rounding errors)
+const double MAX_RELATIVE_ERROR = 1e-10;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Output arrays of one grid evaluation (position, first and second derivatives, normal)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct GridArrays {
+
+    explicit GridArrays(size_t number_of_points) : data(21, vector<double>(number_of_points)) {
+        for (int d = 0; d < 3; ++d) {
+            buffers.position[d] = data[d].data();
+            buffers.d1u[d] = data[3 + d].data();
+            buffers.d1v[d] = data[6 + d].data();
+            buffers.d2u[d] = data[9 + d].data();
+            buffers.d2uv[d] = data[12 + d].data();
+            buffers.d2v[d] = data[15 + d].data();
+            buffers.normal[d] = data[18 + d].data();
+        }
+    }
+
+    // Largest error of the seven quantities (position, derivatives and normal) relative to the reference, each
+    // divided by the largest magnitude of the quantity in the reference: the second derivatives of the rational
+    // surfaces are orders of magnitude larger than the positions, so a single absolute error would hide the positions
+    double relative_error(const GridArrays &reference) const {
+        double largest_error = 0.0;
+        for (size_t quantity = 0; quantity < 7; ++quantity) {
+            double error = 0.0, magnitude = 0.0;
+            for (size_t a = 3 * quantity; a < 3 * quantity + 3; ++a) {
+                for (size_t k = 0; k < data[a].size(); ++k) {
+                    error = max(error, fabs(data[a][k] - reference.data[a][k]));
+                    magnitude = max(magnitude, fabs(reference.data[a][k]));
+                }
+            }
+            largest_error = max(largest_error, error / max(magnitude, 1e-300));
+        }
+        return largest_error;
+    }
+
+    vector<vector<double>> data;
+    SurfaceGridBuffers buffers;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Reference evaluation with Geom_BSplineSurface::D2 at every point
+// ------------------------------------------------------------------------------------------------------------------ //
+void evaluate_with_d2(const Handle(Geom_BSplineSurface) &surface, const vector<double> &u, const vector<double> &v,
+                      GridArrays &arrays) {
+
+    gp_Pnt P;
+    gp_Vec D1U, D1V, D2U, D2V, D2UV;
+    for (size_t i = 0; i < u.size(); ++i) {
+        for (size_t j = 0; j < v.size(); ++j) {
+            surface->D2(u[i], v[j], P, D1U, D1V, D2U, D2V, D2UV);
+            size_t k = i * v.size() + j;
+            for (int d = 0; d < 3; ++d) {
+                arrays.data[d][k] = P.Coord(d + 1);
+                arrays.data[3 + d][k] = D1U.Coord(d + 1);
+                arrays.data[6 + d][k] = D1V.Coord(d + 1);
+                arrays.data[9 + d][k] = D2U.Coord(d + 1);
+                arrays.data[12 + d][k] = D2UV.Coord(d + 1);
+                arrays.data[15 + d][k] = D2V.Coord(d + 1);
+            }
+            gp_Vec normal = D1U.Crossed(D1V);
+            double length = normal.Magnitude();
+            for (int d = 0; d < 3; ++d) { arrays.data[18 + d][k] = length > 0.0 ? normal.Coord(d + 1) / length : 0.0; }
+        }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+    long grid_size_argument = argc > 1 ? atol(argv[1]) : 1000;
+    if (grid_size_argument < 2) {
+        cerr << "The grid size must be at least 2 (got " << grid_size_argument << ")" << endl;
+        return 1;
+    }
+    size_t grid_size = size_t(grid_size_argument);
+    int number_of_threads = resolve_number_of_threads(argc > 2 ? atoi(argv[2]) : 0);
+    mt19937 generator(0);
+    uniform_real_distribution<double> distribution(0.5, 1.5);
+
+    // Parameters of the grid (the same in both directions)
+    vector<double> parameters(grid_size);
+    for (size_t i = 0; i < grid_size; ++i) { parameters[i] = double(i) / double(grid_size - 1); }
+
+    cout << "\n\nEvaluation of the position, derivatives up to the second order and normal on a " << grid_size << " x "
+         << grid_size << " grid (times in milliseconds)" << endl;
+    cout << setw(26) << "Surface" << setw(12) << "D2" << setw(12) << "Grid (1)" << setw(12)
+         << "Grid (" + to_string(number_of_threads) + ")" << setw(12) << "Basis" << setw(10) << "Speed-up"
+         << setw(16) << "Relative error" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+    double largest_error = 0.0;
+    for (int degree : {3, 5}) {
+        for (bool rational : {false, true}) {
+
+            // Surface with 32 x 32 poles and equispaced knots
+            int number_of_poles = 32;
+            TColgp_Array2OfPnt poles(1, number_of_poles, 1, number_of_poles);
+            TColStd_Array2OfReal weights(1, number_of_poles, 1, number_of_poles);
+            for (int i = 1; i <= number_of_poles; ++i) {
+                for (int j = 1; j <= number_of_poles; ++j) {
+                    poles(i, j) = gp_Pnt(i, j, distribution(generator));
+                    weights(i, j) = distribution(generator);
+                }
+            }
+            TColStd_Array1OfReal knots(0, number_of_poles - degree);
+            TColStd_Array1OfInteger mults(0, number_of_poles - degree);
+            for (int i = 0; i <= number_of_poles - degree; ++i) {
+                knots(i) = double(i) / double(number_of_poles - degree);
+                mults(i) = (i == 0 || i == number_of_poles - degree) ? degree + 1 : 1;
+            }
+            Handle(Geom_BSplineSurface) surface =
+                    rational ? new Geom_BSplineSurface(poles, weights, knots, knots, mults, mults, degree, degree)
+                             : new Geom_BSplineSurface(poles, knots, knots, mults, mults, degree, degree);
+
+            // Reference
+            GridArrays reference(grid_size * grid_size);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            evaluate_with_d2(surface, parameters, parameters, reference);
+            double d2_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            // Grid evaluator on one thread and on all the threads
+            GridArrays grid(grid_size * grid_size);
+            start = chrono::steady_clock::now();
+            evaluate_surface_grid(surface, parameters, parameters, grid.buffers, 1);
+            double serial_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            SurfaceGridStats stats;
+            start = chrono::steady_clock::now();
+            evaluate_surface_grid(surface, parameters, parameters, grid.buffers, number_of_threads, &stats);
+            double parallel_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            double error = grid.relative_error(reference);
+            largest_error = max(largest_error, error);
+
+            string name = "32x32, p=" + to_string(degree) + (rational ? ", NURBS" : "");
+            cout << setw(26) << name << setw(12) << d2_time << setw(12) << serial_time << setw(12) << parallel_time
+                 << setw(12) << 1000.0 * stats.basis_seconds << setw(10) << d2_time / max(parallel_time, 1e-6)
+                 << setw(16) << scientific << error << fixed << endl;
+
+        }
+    }
+
+    // Check the results against the tolerance
+    if (largest_error > MAX_RELATIVE_ERROR) {
+        cerr << "\nThe grid evaluator differs from Geom_BSplineSurface::D2 by a relative error of " << scientific
+             << largest_error << " (tolerance " << MAX_RELATIVE_ERROR << ")" << endl;
+        return 1;
+    }
+    cout << "\nLargest relative error: " << scientific << largest_error << " (tolerance " << MAX_RELATIVE_ERROR << ")"
+         << endl;
+
+
+    return 0;
+
+
+}
@@ -0,0 +1,298 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of symmetric models built from transformed copies of a rational Bezier patch
+//  The patches are transformed by copying their geometry or by changing their location (see located_transform.h)
+//  and by the symmetry groups of symmetric_model.h
+//  The located models are compared face by face with the copied models (centroid, point and oriented normal at the
+//  centre of the parameters), before and after a round trip through the BRep cache, and the program fails (exit
+//  code 1) if any face differs
+//  Usage: benchmark_symmetric_model
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <Geom_BezierSurface.hxx>
+#include <Geom_Surface.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopExp_Explorer.hxx>
+#include <BRep_Tool.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepTools.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+
+
+// Include the shared demo library
+#include "brep_cache.h"
+#include "located_transform.h"
+#include "parallel_for.h"
+#include "symmetric_model.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Rational Bezier patch of demo_bezier_surface_rational (a cylindrical sector of 90 degrees)
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_patch() {
+
+    TColgp_Array2OfPnt P(1, 3, 1, 2);
+    P(1, 1) = gp_Pnt(1.0, 0.0, 0.0);
+    P(2, 1) = gp_Pnt(1.0, 1.0, 0.0);
+    P(3, 1) = gp_Pnt(0.0, 1.0, 0.0);
+    P(1, 2) = gp_Pnt(1.0, 0.0, 2.0);
+    P(2, 2) = gp_Pnt(1.0, 1.0, 2.0);
+    P(3, 2) = gp_Pnt(0.0, 1.0, 2.0);
+    TColStd_Array2OfReal W(1, 3, 1, 2);
+    W(1, 1) = W(3, 1) = W(1, 2) = W(3, 2) = 1.0;
+    W(2, 1) = W(2, 2) = sqrt(2.0) / 2.0;
+    return BRepBuilderAPI_MakeFace(new Geom_BezierSurface(P, W), 0.0);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Model with the patch and its mirror image (in the XZ plane) rotated to the sectors of a circle
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Compound make_symmetric_model(const TopoDS_Face &patch, int number_of_sectors, bool use_locations) {
+
+    gp_Trsf mirror;
+    mirror.SetMirror(gp::ZOX());
+    TopoDS_Shape mirrored_patch = use_locations ? located_transform(patch, mirror) : TopoDS_Shape();
+
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    for (int i = 0; i < number_of_sectors; ++i) {
+        gp_Trsf rotation;
+        rotation.SetRotation(gp::OZ(), 2.0 * M_PI * i / number_of_sectors);
+        if (use_locations) {
+            // mirror(rotation(patch)) is equal to inverse_rotation(mirror(patch))
+            builder.Add(compound, located_transform(patch, rotation));
+            builder.Add(compound, located_transform(mirrored_patch, rotation.Inverted()));
+        }
+        else {
+            builder.Add(compound, BRepBuilderAPI_Transform(patch, rotation, Standard_True).Shape());
+            builder.Add(compound, BRepBuilderAPI_Transform(patch, mirror.Multiplied(rotation), Standard_True).Shape());
+        }
+    }
+    return compound;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Number of distinct surfaces of the faces of a shape (the located faces share the surface of their TShape)
+// ------------------------------------------------------------------------------------------------------------------ //
+size_t count_distinct_surfaces(const TopoDS_Shape &shape) {
+
+    set<const void *> surfaces;
+    for (TopExp_Explorer explorer(shape, TopAbs_FACE); explorer.More(); explorer.Next()) {
+        TopLoc_Location location;
+        surfaces.insert(BRep_Tool::Surface(TopoDS::Face(explorer.Current()), location).get());
+    }
+    return surfaces.size();
+
+}
+
+
+// Area of the faces of a shape
+double area(const TopoDS_Shape &shape) {
+
+    GProp_GProps properties;
+    BRepGProp::SurfaceProperties(shape, properties);
+    return properties.Mass();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Compare two models face by face (in the order of the explorer) and return the largest difference
+// The centroid does not see the orientation of a face, so each face also gives its point and its normal (reversed
+// with the face) at the centre of its parameters, which differ if a mirror is missing, composed in the wrong order or
+// turns the face inside out
+// ------------------------------------------------------------------------------------------------------------------ //
+double largest_face_difference(const TopoDS_Shape &shape, const TopoDS_Shape &reference) {
+
+    double largest_difference = 0.0;
+    TopExp_Explorer explorer(shape, TopAbs_FACE), reference_explorer(reference, TopAbs_FACE);
+    for (; explorer.More() && reference_explorer.More(); explorer.Next(), reference_explorer.Next()) {
+
+        const TopoDS_Face *faces[2] = {&TopoDS::Face(explorer.Current()), &TopoDS::Face(reference_explorer.Current())};
+        gp_Pnt centroids[2], points[2];
+        gp_Vec normals[2];
+        for (int k = 0; k < 2; ++k) {
+            GProp_GProps properties;
+            BRepGProp::SurfaceProperties(*faces[k], properties);
+            centroids[k] = properties.CentreOfMass();
+
+            // The adaptor applies the location of the face to the surface
+            double u_min, u_max, v_min, v_max;
+            BRepTools::UVBounds(*faces[k], u_min, u_max, v_min, v_max);
+            BRepAdaptor_Surface surface(*faces[k]);
+            gp_Vec d1u, d1v;
+            surface.D1(0.5 * (u_min + u_max), 0.5 * (v_min + v_max), points[k], d1u, d1v);
+            normals[k] = d1u.Crossed(d1v).Normalized();
+            if (faces[k]->Orientation() == TopAbs_REVERSED) { normals[k].Reverse(); }
+        }
+        largest_difference = max(largest_difference, centroids[0].Distance(centroids[1]));
+        largest_difference = max(largest_difference, points[0].Distance(points[1]));
+        largest_difference = max(largest_difference, (normals[0] - normals[1]).Magnitude());
+
+    }
+
+    // A missing face is a difference of its own
+    if (explorer.More() || reference_explorer.More()) { return HUGE_VAL; }
+    return largest_difference;
+
+}
+
+
+// Size of a file in kilobytes
+double file_size_kilobytes(const string &file_name) {
+
+    struct stat file_status;
+    if (stat(file_name.c_str(), &file_status) != 0) { return 0.0; }
+    return file_status.st_size / 1024.0;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main() {
+
+    string relative_path = "../output/";
+    TopoDS_Face patch = make_patch();
+
+    cout << "\n\nSymmetric model with a patch and its mirror image per sector (build time in milliseconds, BRep size "
+         << "in kilobytes)" << endl;
+    cout << setw(10) << "Sectors" << setw(12) << "Method" << setw(12) << "Build" << setw(12) << "Surfaces"
+         << setw(14) << "BRep [kB]" << setw(14) << "Area" << setw(14) << "Difference" << setw(14) << "Read back"
+         << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+    // Largest distance (between points, or between unit normals) accepted between the faces of two models
+    const double tolerance = 1e-7;
+    double largest_difference = 0.0;
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Compare the located patches with the copies of the geometry, before and after a round trip through a BRep file
+    // -------------------------------------------------------------------------------------------------------------- //
+    for (int number_of_sectors : {8, 64, 512}) {
+        TopoDS_Compound copied_model;
+        for (bool use_locations : {false, true}) {
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            TopoDS_Compound model = make_symmetric_model(patch, number_of_sectors, use_locations);
+            double build = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            string model_name = "symmetric_model_" + to_string(number_of_sectors) + (use_locations ? "_located" : "");
+            write_brep_file(relative_path, model_name, model);
+
+            cout << setw(10) << number_of_sectors << setw(12) << (use_locations ? "location" : "copy")
+                 << setw(12) << build << setw(12) << count_distinct_surfaces(model)
+                 << setw(14) << file_size_kilobytes(relative_path + model_name + BREP_CACHE_EXTENSION)
+                 << setw(14) << area(model);
+            if (!use_locations) {
+                copied_model = model;
+                cout << endl;
+                continue;
+            }
+
+            // The copied model is the reference of the located one
+            double difference = largest_face_difference(model, copied_model);
+            TopoDS_Shape read_model;
+            bool is_read = read_brep_file(relative_path + model_name + BREP_CACHE_EXTENSION, read_model);
+            double read_difference = is_read ? largest_face_difference(read_model, copied_model) : HUGE_VAL;
+            largest_difference = max(largest_difference, max(difference, read_difference));
+            cout << scientific << setw(14) << difference << setw(14) << read_difference << fixed << endl;
+
+        }
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Dihedral groups of turbomachinery rows: creation of the lazy model, located and copied compounds
+    // -------------------------------------------------------------------------------------------------------------- //
+    int number_of_threads = resolve_number_of_threads(0);
+    cout << "\n\nSymmetric model of a dihedral group (creation time in microseconds, materialisation in milliseconds, "
+         << number_of_threads << " threads)" << endl;
+    cout << setw(10) << "Sectors" << setw(12) << "Instances" << setw(12) << "Create" << setw(14) << "Located x1"
+         << setw(14) << "Located xN" << setw(12) << "Copy xN" << setw(12) << "Surfaces" << setw(14) << "Difference"
+         << endl;
+
+    for (int number_of_sectors : {40, 120, 1000, 10000}) {
+
+        // The mirror plane contains the axis of rotation
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        SymmetryGroup group(gp::OZ(), number_of_sectors);
+        group.add_mirror_plane(gp::ZOX());
+        SymmetricModel model(patch, group);
+        double create = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        TopoDS_Compound serial_model = model.materialise(1);
+        double located_serial = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        TopoDS_Compound parallel_model = model.materialise(number_of_threads);
+        double located_parallel = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        TopoDS_Compound copied_model = model.materialise(number_of_threads, true);
+        double copied_parallel = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // The located compounds must match the copied one
+        double difference = max(largest_face_difference(serial_model, copied_model),
+                                largest_face_difference(parallel_model, copied_model));
+        largest_difference = max(largest_difference, difference);
+
+        cout << setw(10) << number_of_sectors << setw(12) << model.size() << setw(12) << create
+             << setw(14) << located_serial << setw(14) << located_parallel << setw(12) << copied_parallel
+             << setw(12) << count_distinct_surfaces(parallel_model) << scientific << setw(14) << difference << fixed
+             << endl;
+
+    }
+
+    // Fail if a located model differs from its copy
+    if (largest_difference > tolerance) {
+        cerr << "\nA located model differs from the copied model by " << scientific << largest_difference
+             << " (tolerance " << tolerance << ")" << endl;
+        return 1;
+    }
+
+
+    return 0;
+
+
+}
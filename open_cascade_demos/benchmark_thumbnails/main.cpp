@@ -0,0 +1,113 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Benchmark of the CPU thumbnail renderer for every demo model
+//  Usage: benchmark_thumbnails [number_of_repetitions] [image_size]
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Include the shared demo library
+#include "demo_models.h"
+#include "parallel_for.h"
+#include "thumbnail_renderer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Average time to render a thumbnail in milliseconds
+// ------------------------------------------------------------------------------------------------------------------ //
+double render_time(const TopoDS_Shape &shape, const ThumbnailOptions &options, int number_of_repetitions) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < number_of_repetitions; ++i) { render_thumbnail(shape, options); }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / number_of_repetitions;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Main body
+// ------------------------------------------------------------------------------------------------------------------ //
+int main(int argc, char *argv[]) {
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Load the models of the demonstration scripts
+    // -------------------------------------------------------------------------------------------------------------- //
+    int number_of_repetitions = argc > 1 ? atoi(argv[1]) : 20;
+    int image_size = argc > 2 ? atoi(argv[2]) : 512;
+    vector<DemoModel> models = load_demo_models();
+    if (models.empty()) {
+        cout << "No demo models found. Run the demonstration scripts first." << endl;
+        return 1;
+    }
+
+    string relative_path = "../output/";
+    int number_of_threads = resolve_number_of_threads(0);
+    ThumbnailOptions serial_options, parallel_options;
+    serial_options.width = serial_options.height = image_size;
+    serial_options.number_of_threads = 1;
+    parallel_options.width = parallel_options.height = image_size;
+    parallel_options.number_of_threads = number_of_threads;
+    int number_of_failures = 0;
+
+    cout << "\n\nTime per " << image_size << "x" << image_size << " thumbnail (milliseconds), average over "
+         << number_of_repetitions << " repetitions" << endl;
+    cout << "The first render includes the tessellation, the others reuse the triangulation stored in the faces" << endl;
+    cout << setw(40) << "Demo" << setw(14) << "First render" << setw(14) << "1 thread"
+         << setw(14) << to_string(number_of_threads) + " threads" << setw(12) << "Speed-up" << endl;
+    cout.precision(3);
+    cout.setf(ios::fixed);
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Render every model with one thread and with all the threads
+    // -------------------------------------------------------------------------------------------------------------- //
+    double total_serial = 0.0, total_parallel = 0.0;
+    for (const DemoModel &model : models) {
+
+        // Tessellate and render the model once, and keep the image
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (!write_thumbnail(relative_path + model.demo_name + ".png", model.model_object, parallel_options)) {
+            number_of_failures++;
+        }
+        double first_render = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Render the model again (the triangulation is reused)
+        double serial = render_time(model.model_object, serial_options, number_of_repetitions);
+        double parallel = render_time(model.model_object, parallel_options, number_of_repetitions);
+        total_serial += serial;
+        total_parallel += parallel;
+
+        cout << setw(40) << model.demo_name << setw(14) << first_render << setw(14) << serial
+             << setw(14) << parallel << setw(12) << serial / parallel << endl;
+
+    }
+
+    cout << "\n\nThumbnails per hour (one model at a time, all threads): "
+         << int(3.6e6 * models.size() / total_parallel) << endl;
+    cout << "Thumbnails per hour (one model per thread): "
+         << int(3.6e6 * models.size() * number_of_threads / total_serial) << endl;
+    cout << "Failed writes: " << number_of_failures << endl;
+
+
+    return number_of_failures == 0 ? 0 : 1;
+
+
+}
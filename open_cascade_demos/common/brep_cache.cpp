@@ -0,0 +1,115 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Binary BRep cache written next to the .step files
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <istream>
+#include <streambuf>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <BinTools.hxx>
+#include <Standard_Failure.hxx>
+
+
+// Include the header of this module
+#include "brep_cache.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Extension of the binary BRep files
+const char *const BREP_CACHE_EXTENSION = ".bbrep";
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read-only stream buffer over a block of memory (the memory-mapped file)
+// ------------------------------------------------------------------------------------------------------------------ //
+class MemoryStreamBuffer : public streambuf {
+
+public:
+
+    MemoryStreamBuffer(const char *data, size_t size) {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+
+    // The binary reader may move around the stream, so seeking within the block is supported
+    pos_type seekoff(off_type offset, ios_base::seekdir direction, ios_base::openmode mode) override {
+        char *position = direction == ios_base::beg ? eback() : direction == ios_base::cur ? gptr() : egptr();
+        position += offset;
+        if (!(mode & ios_base::in) || position < eback() || position > egptr()) { return pos_type(off_type(-1)); }
+        setg(eback(), position, egptr());
+        return pos_type(off_type(position - eback()));
+    }
+
+    pos_type seekpos(pos_type position, ios_base::openmode mode) override {
+        return seekoff(off_type(position), ios_base::beg, mode);
+    }
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write the shape to a binary BRep file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_brep_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
+
+    // Create the output directory if it does not exist
+    mkdir(relative_path.c_str(), 0777);     // 0777 is used to give the user permissions to read+write+execute
+
+    // Write the binary file
+    string file_name = relative_path + model_name + BREP_CACHE_EXTENSION;
+    return BinTools::Write(model_object, file_name.c_str());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read a binary BRep file through a memory map
+// ------------------------------------------------------------------------------------------------------------------ //
+bool read_brep_file(const string &file_name, TopoDS_Shape &model_object) {
+
+    // Open the file and get its size
+    int file_descriptor = open(file_name.c_str(), O_RDONLY);
+    if (file_descriptor < 0) { return false; }
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size == 0) {
+        close(file_descriptor);
+        return false;
+    }
+
+    // Map the file into memory (the mapping stays valid after closing the file descriptor)
+    size_t size = size_t(file_status.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+    if (data == MAP_FAILED) { return false; }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    // Parse the shape directly from the mapped memory
+    bool is_done = true;
+    try {
+        MemoryStreamBuffer buffer(static_cast<const char *>(data), size);
+        istream stream(&buffer);
+        BinTools::Read(model_object, stream);
+        is_done = !stream.bad() && !model_object.IsNull();
+    }
+    catch (const Standard_Failure &) {
+        is_done = false;
+    }
+
+    munmap(data, size);
+    return is_done;
+
+}
@@ -0,0 +1,34 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Binary BRep cache written next to the .step files
+//
+//  The shapes are serialized with the native binary format of OpenCascade (BinTools), which stores the topology and
+//  the geometry exactly as they are in memory and does not need any translation when it is read back. The loader
+//  memory-maps the file and parses it in place, without copying it into an intermediate buffer.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef BREP_CACHE_H
+#define BREP_CACHE_H
+
+
+// Include standard C++ libraries
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Extension of the binary BRep files
+extern const char *const BREP_CACHE_EXTENSION;
+
+
+// Write the shape to the binary file <relative_path><model_name>.bbrep
+bool write_brep_file(const std::string &relative_path, const std::string &model_name, const TopoDS_Shape &model_object);
+
+// Read a binary BRep file through a memory map (returns false if the file cannot be read)
+bool read_brep_file(const std::string &file_name, TopoDS_Shape &model_object);
+
+
+#endif //BREP_CACHE_H
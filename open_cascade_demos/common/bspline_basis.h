@@ -0,0 +1,177 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  B-Spline basis functions on a flat knot vector
+//
+//  These are the span search, basis function and basis derivative algorithms of The NURBS Book (Piegl and Tiller,
+//  algorithms A2.1, A2.2 and A2.3) with zero-based indices. A B-Spline of degree p with n+1 poles has the flat knot
+//  vector U[0], ..., U[n+p+1] (the knots repeated as many times as their multiplicity, see Law_BSpline::KnotSequence).
+//  The knot span s of the parameter u is the index with U[s] <= u < U[s+1] and p <= s <= n, and the only basis
+//  functions that are non-zero on it are N[s-p], ..., N[s].
+//
+//  The parameters before U[p] or after U[n+1] are assigned to the first or the last span, so the B-Spline is
+//  extrapolated by the polynomial of its end spans (like the evaluators of OpenCascade).
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef BSPLINE_BASIS_H
+#define BSPLINE_BASIS_H
+
+
+// Include standard C++ libraries
+#include <cmath>
+
+
+// Maximum degree of the B-Splines of OpenCascade (BSplCLib::MaxDegree)
+const int MAX_BSPLINE_DEGREE = 25;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Knot span of the parameter u (binary search)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline int find_bspline_span(const double *knots, int number_of_poles, int degree, double u) {
+
+    int last = number_of_poles - 1;
+    if (u >= knots[last + 1]) { return last; }
+    if (u <= knots[degree]) { return degree; }
+
+    // Invariant: knots[low] <= u < knots[high]
+    int low = degree, high = last + 1;
+    while (high - low > 1) {
+        int middle = (low + high) / 2;
+        if (u < knots[middle]) { high = middle; }
+        else { low = middle; }
+    }
+    return low;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Knot span of the parameter u starting from the span of a previous parameter (cheap when the parameters are sorted)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline int find_bspline_span(const double *knots, int number_of_poles, int degree, double u, int previous_span) {
+
+    // Walk forward over the next spans, and fall back to the binary search if the parameter went backward
+    int last = number_of_poles - 1;
+    if (previous_span < degree || previous_span > last || (u < knots[previous_span] && previous_span > degree)) {
+        return find_bspline_span(knots, number_of_poles, degree, u);
+    }
+    int span = previous_span;
+    while (span < last && u >= knots[span + 1]) { ++span; }
+    return span;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Values of the basis functions N[span-degree], ..., N[span] at the parameter u (basis has degree+1 entries)
+// The scheme builds the basis functions of the lower degrees first: lower_basis, if given, receives the degree entries
+// of the basis functions of degree-1 (needed for the first derivative)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline void bspline_basis_functions(const double *knots, int span, int degree, double u, double *basis,
+                                    double *lower_basis = nullptr) {
+
+    double left[MAX_BSPLINE_DEGREE + 1];
+    double right[MAX_BSPLINE_DEGREE + 1];
+    basis[0] = 1.0;
+    if (lower_basis != nullptr && degree == 1) { lower_basis[0] = 1.0; }
+    for (int j = 1; j <= degree; ++j) {
+        left[j] = u - knots[span + 1 - j];
+        right[j] = knots[span + j] - u;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            double temp = basis[r] / (right[r + 1] + left[j - r]);
+            basis[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        basis[j] = saved;
+        if (lower_basis != nullptr && j == degree - 1) {
+            for (int r = 0; r <= j; ++r) { lower_basis[r] = basis[r]; }
+        }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Derivatives of orders 0, ..., order of the basis functions N[span-degree], ..., N[span] at the parameter u
+// derivatives[k * (degree+1) + j] receives the derivative of order k of N[span-degree+j] (zero if k > degree)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline void bspline_basis_derivatives(const double *knots, int span, int degree, double u, int order,
+                                      double *derivatives) {
+
+    // Basis functions of all the degrees (upper triangle) and knot differences (lower triangle)
+    const int size = MAX_BSPLINE_DEGREE + 1;
+    double ndu[size][size];
+    double left[size];
+    double right[size];
+    ndu[0][0] = 1.0;
+    for (int j = 1; j <= degree; ++j) {
+        left[j] = u - knots[span + 1 - j];
+        right[j] = knots[span + j] - u;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            ndu[j][r] = right[r + 1] + left[j - r];
+            double temp = ndu[r][j - 1] / ndu[j][r];
+            ndu[r][j] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        ndu[j][j] = saved;
+    }
+
+    int width = degree + 1;
+    for (int k = 0; k <= order; ++k) {
+        for (int j = 0; j <= degree; ++j) { derivatives[k * width + j] = k == 0 ? ndu[j][degree] : 0.0; }
+    }
+
+    // Derivatives of each basis function from the differences of the basis functions of the lower degrees
+    int highest_order = order < degree ? order : degree;
+    double a[2][size];
+    for (int r = 0; r <= degree; ++r) {
+        int s1 = 0, s2 = 1;
+        a[0][0] = 1.0;
+        for (int k = 1; k <= highest_order; ++k) {
+            double d = 0.0;
+            int rk = r - k, pk = degree - k;
+            if (r >= k) {
+                a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                d = a[s2][0] * ndu[rk][pk];
+            }
+            int j1 = rk >= -1 ? 1 : -rk;
+            int j2 = r - 1 <= pk ? k - 1 : degree - r;
+            for (int j = j1; j <= j2; ++j) {
+                a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                d += a[s2][j] * ndu[rk + j][pk];
+            }
+            if (r <= pk) {
+                a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                d += a[s2][k] * ndu[r][pk];
+            }
+            derivatives[k * width + r] = d;
+            int swap = s1; s1 = s2; s2 = swap;
+        }
+    }
+
+    // Multiply by degree * (degree-1) * ... * (degree-k+1)
+    double factor = degree;
+    for (int k = 1; k <= highest_order; ++k) {
+        for (int j = 0; j <= degree; ++j) { derivatives[k * width + j] *= factor; }
+        factor *= degree - k;
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Parameter u brought into the period [first, last) of a periodic B-Spline
+// ------------------------------------------------------------------------------------------------------------------ //
+inline double wrap_periodic_parameter(double u, double first, double last) {
+
+    double period = last - first;
+    double wrapped = first + std::fmod(u - first, period);
+    return wrapped < first ? wrapped + period : wrapped;
+
+}
+
+
+#endif //BSPLINE_BASIS_H
@@ -0,0 +1,359 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Cursors for the sequential sampling of B-Spline curves, surfaces and laws
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cmath>
+
+
+// Include OpenCascade libraries
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+
+
+// Include the header of this module
+#include "bspline_cursor.h"
+
+
+// Include the shared demo library
+#include "bspline_basis.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Divide the derivatives of order k of the basis functions by k! (the rows of bspline_basis_derivatives)
+static void divide_by_factorials(double *derivatives, int degree) {
+
+    double factorial = 1.0;
+    for (int k = 1; k <= degree; ++k) {
+        factorial *= k;
+        for (int j = 0; j <= degree; ++j) { derivatives[k * (degree + 1) + j] /= factorial; }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a B-Spline of one parameter
+// ------------------------------------------------------------------------------------------------------------------ //
+BSplineSpanCursor::BSplineSpanCursor(const vector<double> &knots, int degree, int dimension,
+                                     const vector<double> &poles) :
+        degree_(degree), dimension_(dimension), number_of_poles_(int(poles.size()) / dimension),
+        knots_(knots), poles_(poles), coefficients_(size_t((degree + 1) * dimension), 0.0) {}
+
+
+void BSplineSpanCursor::load_span(int span) {
+
+    // Taylor coefficients at the first knot of the span: c[k] = sum_j N[span-p+j]^(k)(U[span]) / k! * P[span-p+j]
+    int p = degree_;
+    double derivatives[(MAX_BSPLINE_DEGREE + 1) * (MAX_BSPLINE_DEGREE + 1)];
+    bspline_basis_derivatives(knots_.data(), span, p, knots_[span], p, derivatives);
+    divide_by_factorials(derivatives, p);
+
+    const double *poles = poles_.data() + (span - p) * dimension_;
+    for (int k = 0; k <= p; ++k) {
+        for (int d = 0; d < dimension_; ++d) {
+            double sum = 0.0;
+            for (int j = 0; j <= p; ++j) { sum += derivatives[k * (p + 1) + j] * poles[j * dimension_ + d]; }
+            coefficients_[k * dimension_ + d] = sum;
+        }
+    }
+    span_ = span;
+    span_start_ = knots_[span];
+    number_of_span_changes_++;
+
+}
+
+
+void BSplineSpanCursor::evaluate(double u, double *value, double *derivative) {
+
+    // The first call (span_ = -1) locates the span with a binary search
+    int span = find_bspline_span(knots_.data(), number_of_poles_, degree_, u, span_);
+    if (span != span_) { load_span(span); }
+
+    // Horner scheme in the local parameter of the span (and for the derivative of the polynomial)
+    double t = u - span_start_;
+    for (int d = 0; d < dimension_; ++d) {
+        double polynomial = coefficients_[degree_ * dimension_ + d];
+        double slope = 0.0;
+        for (int k = degree_ - 1; k >= 0; --k) {
+            slope = slope * t + polynomial;
+            polynomial = polynomial * t + coefficients_[k * dimension_ + d];
+        }
+        value[d] = polynomial;
+        if (derivative != nullptr) { derivative[d] = slope; }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Geom_BSplineCurve
+// ------------------------------------------------------------------------------------------------------------------ //
+BSplineCurveCursor::BSplineCurveCursor(const Handle(Geom_BSplineCurve) &curve) :
+        is_rational_(curve->IsRational()), is_periodic_(curve->IsPeriodic()), cursor_(make_cursor(curve)) {}
+
+
+BSplineSpanCursor BSplineCurveCursor::make_cursor(const Handle(Geom_BSplineCurve) &curve) {
+
+    // The periodic curves are converted on a copy
+    Handle(Geom_BSplineCurve) clamped = curve;
+    if (curve->IsPeriodic()) {
+        clamped = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+        clamped->SetNotPeriodic();
+    }
+
+    int n = clamped->NbPoles(), p = clamped->Degree();
+    TColStd_Array1OfReal flat_knots(1, n + p + 1);
+    clamped->KnotSequence(flat_knots);
+    TColgp_Array1OfPnt poles(1, n);
+    clamped->Poles(poles);
+    TColStd_Array1OfReal weights(1, n);
+    bool is_rational = clamped->IsRational();
+    if (is_rational) { clamped->Weights(weights); }
+
+    // Homogeneous coordinates (x w, y w, z w, w) of the rational curves
+    vector<double> coordinates;
+    coordinates.reserve(size_t(n * (is_rational ? 4 : 3)));
+    for (int i = 1; i <= n; ++i) {
+        double w = is_rational ? weights(i) : 1.0;
+        coordinates.push_back(poles(i).X() * w);
+        coordinates.push_back(poles(i).Y() * w);
+        coordinates.push_back(poles(i).Z() * w);
+        if (is_rational) { coordinates.push_back(w); }
+    }
+    return BSplineSpanCursor(vector<double>(&flat_knots(1), &flat_knots(1) + flat_knots.Length()), p,
+                             is_rational ? 4 : 3, coordinates);
+
+}
+
+
+double BSplineCurveCursor::periodic_parameter(double u) const {
+
+    return is_periodic_ ? wrap_periodic_parameter(u, cursor_.first_parameter(), cursor_.last_parameter()) : u;
+
+}
+
+
+gp_Pnt BSplineCurveCursor::value(double u) {
+
+    double h[4];
+    cursor_.evaluate(periodic_parameter(u), h);
+    if (!is_rational_) { return gp_Pnt(h[0], h[1], h[2]); }
+    return gp_Pnt(h[0] / h[3], h[1] / h[3], h[2] / h[3]);
+
+}
+
+
+void BSplineCurveCursor::d1(double u, gp_Pnt &point, gp_Vec &tangent) {
+
+    double h[4], dh[4];
+    cursor_.evaluate(periodic_parameter(u), h, dh);
+    if (!is_rational_) {
+        point.SetCoord(h[0], h[1], h[2]);
+        tangent.SetCoord(dh[0], dh[1], dh[2]);
+        return;
+    }
+
+    // C = H / w and C' = (H' - C w') / w
+    double w = h[3], dw = dh[3];
+    point.SetCoord(h[0] / w, h[1] / w, h[2] / w);
+    tangent.SetCoord((dh[0] - point.X() * dw) / w, (dh[1] - point.Y() * dw) / w, (dh[2] - point.Z() * dw) / w);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Law_BSpline
+// ------------------------------------------------------------------------------------------------------------------ //
+BSplineLawCursor::BSplineLawCursor(const Law_BSpline &law) :
+        is_rational_(law.IsRational()), is_periodic_(law.IsPeriodic()), cursor_(make_cursor(law)) {}
+
+
+BSplineSpanCursor BSplineLawCursor::make_cursor(const Law_BSpline &law) {
+
+    // The periodic laws are converted on a copy
+    Handle(Law_BSpline) clamped = law.Copy();
+    if (clamped->IsPeriodic()) { clamped->SetNotPeriodic(); }
+
+    int n = clamped->NbPoles(), p = clamped->Degree();
+    TColStd_Array1OfReal flat_knots(1, n + p + 1);
+    clamped->KnotSequence(flat_knots);
+    TColStd_Array1OfReal poles(1, n);
+    clamped->Poles(poles);
+    TColStd_Array1OfReal weights(1, n);
+    bool is_rational = clamped->IsRational();
+    if (is_rational) { clamped->Weights(weights); }
+
+    // Homogeneous coordinates (f w, w) of the rational laws
+    vector<double> coordinates;
+    coordinates.reserve(size_t(n * (is_rational ? 2 : 1)));
+    for (int i = 1; i <= n; ++i) {
+        double w = is_rational ? weights(i) : 1.0;
+        coordinates.push_back(poles(i) * w);
+        if (is_rational) { coordinates.push_back(w); }
+    }
+    return BSplineSpanCursor(vector<double>(&flat_knots(1), &flat_knots(1) + flat_knots.Length()), p,
+                             is_rational ? 2 : 1, coordinates);
+
+}
+
+
+double BSplineLawCursor::periodic_parameter(double u) const {
+
+    return is_periodic_ ? wrap_periodic_parameter(u, cursor_.first_parameter(), cursor_.last_parameter()) : u;
+
+}
+
+
+double BSplineLawCursor::value(double u) {
+
+    double h[2];
+    cursor_.evaluate(periodic_parameter(u), h);
+    return is_rational_ ? h[0] / h[1] : h[0];
+
+}
+
+
+void BSplineLawCursor::d1(double u, double &value, double &derivative) {
+
+    double h[2], dh[2];
+    cursor_.evaluate(periodic_parameter(u), h, dh);
+    if (!is_rational_) {
+        value = h[0];
+        derivative = dh[0];
+        return;
+    }
+    value = h[0] / h[1];
+    derivative = (dh[0] - value * dh[1]) / h[1];
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Geom_BSplineSurface
+// ------------------------------------------------------------------------------------------------------------------ //
+BSplineSurfaceCursor::BSplineSurfaceCursor(const Handle(Geom_BSplineSurface) &surface) :
+        data_(surface),
+        coefficients_(size_t((data_.u_degree + 1) * (data_.v_degree + 1) * data_.dimension), 0.0) {}
+
+
+void BSplineSurfaceCursor::load_patch(int u_span, int v_span) {
+
+    // Taylor coefficients of the basis functions of both directions at the first knots of the spans
+    int p = data_.u_degree, q = data_.v_degree, dimension = data_.dimension;
+    double u_derivatives[(MAX_BSPLINE_DEGREE + 1) * (MAX_BSPLINE_DEGREE + 1)];
+    double v_derivatives[(MAX_BSPLINE_DEGREE + 1) * (MAX_BSPLINE_DEGREE + 1)];
+    bspline_basis_derivatives(data_.u_knots.data(), u_span, p, data_.u_knots[u_span], p, u_derivatives);
+    bspline_basis_derivatives(data_.v_knots.data(), v_span, q, data_.v_knots[v_span], q, v_derivatives);
+    divide_by_factorials(u_derivatives, p);
+    divide_by_factorials(v_derivatives, q);
+
+    // Contract the poles with the v coefficients first, one coordinate array of the net at a time:
+    // rows[(i * (q+1) + l) * dimension + d]
+    vector<double> rows(size_t((p + 1) * (q + 1) * dimension), 0.0);
+    for (int d = 0; d < dimension; ++d) {
+        const double *coordinate = data_.poles.coordinate(d);
+        for (int i = 0; i <= p; ++i) {
+            const double *row = coordinate + (u_span - p + i) * data_.number_of_v_poles + v_span - q;
+            for (int l = 0; l <= q; ++l) {
+                double sum = 0.0;
+                for (int j = 0; j <= q; ++j) { sum += v_derivatives[l * (q + 1) + j] * row[j]; }
+                rows[(i * (q + 1) + l) * dimension + d] = sum;
+            }
+        }
+    }
+
+    // Then with the u coefficients
+    fill(coefficients_.begin(), coefficients_.end(), 0.0);
+    for (int k = 0; k <= p; ++k) {
+        for (int i = 0; i <= p; ++i) {
+            double factor = u_derivatives[k * (p + 1) + i];
+            for (int l = 0; l <= q; ++l) {
+                int offset = (k * (q + 1) + l) * dimension, row_offset = (i * (q + 1) + l) * dimension;
+                for (int d = 0; d < dimension; ++d) { coefficients_[offset + d] += factor * rows[row_offset + d]; }
+            }
+        }
+    }
+
+    u_span_ = u_span;
+    v_span_ = v_span;
+    u_span_start_ = data_.u_knots[u_span];
+    v_span_start_ = data_.v_knots[v_span];
+    number_of_patch_changes_++;
+
+}
+
+
+void BSplineSurfaceCursor::evaluate(double u, double v, double *value, double *d1u, double *d1v) {
+
+    u = data_.wrap_u(u);
+    v = data_.wrap_v(v);
+    int u_span = find_bspline_span(data_.u_knots.data(), data_.number_of_u_poles, data_.u_degree, u, u_span_);
+    int v_span = find_bspline_span(data_.v_knots.data(), data_.number_of_v_poles, data_.v_degree, v, v_span_);
+    if (u_span != u_span_ || v_span != v_span_) { load_patch(u_span, v_span); }
+
+    // Horner scheme in v for every power of the u parameter, then in u
+    int p = data_.u_degree, q = data_.v_degree, dimension = data_.dimension;
+    double s = u - u_span_start_, t = v - v_span_start_;
+    double b[MAX_BSPLINE_DEGREE + 1];
+    double db[MAX_BSPLINE_DEGREE + 1];
+    for (int d = 0; d < dimension; ++d) {
+        for (int k = 0; k <= p; ++k) {
+            const double *c = coefficients_.data() + k * (q + 1) * dimension + d;
+            double polynomial = c[q * dimension], slope = 0.0;
+            for (int l = q - 1; l >= 0; --l) {
+                slope = slope * t + polynomial;
+                polynomial = polynomial * t + c[l * dimension];
+            }
+            b[k] = polynomial;
+            db[k] = slope;
+        }
+        double polynomial = b[p], slope = 0.0, cross = db[p];
+        for (int k = p - 1; k >= 0; --k) {
+            slope = slope * s + polynomial;
+            polynomial = polynomial * s + b[k];
+            cross = cross * s + db[k];
+        }
+        value[d] = polynomial;
+        if (d1u != nullptr) { d1u[d] = slope; }
+        if (d1v != nullptr) { d1v[d] = cross; }
+    }
+
+}
+
+
+gp_Pnt BSplineSurfaceCursor::value(double u, double v) {
+
+    double h[4];
+    evaluate(u, v, h, nullptr, nullptr);
+    if (data_.dimension == 3) { return gp_Pnt(h[0], h[1], h[2]); }
+    return gp_Pnt(h[0] / h[3], h[1] / h[3], h[2] / h[3]);
+
+}
+
+
+void BSplineSurfaceCursor::d1(double u, double v, gp_Pnt &point, gp_Vec &d1u, gp_Vec &d1v) {
+
+    double h[4], hu[4], hv[4];
+    evaluate(u, v, h, hu, hv);
+    if (data_.dimension == 3) {
+        point.SetCoord(h[0], h[1], h[2]);
+        d1u.SetCoord(hu[0], hu[1], hu[2]);
+        d1v.SetCoord(hv[0], hv[1], hv[2]);
+        return;
+    }
+
+    // S = H / w and dS = (dH - S dw) / w in both directions
+    double w = h[3];
+    point.SetCoord(h[0] / w, h[1] / w, h[2] / w);
+    d1u.SetCoord((hu[0] - point.X() * hu[3]) / w, (hu[1] - point.Y() * hu[3]) / w, (hu[2] - point.Z() * hu[3]) / w);
+    d1v.SetCoord((hv[0] - point.X() * hv[3]) / w, (hv[1] - point.Y() * hv[3]) / w, (hv[2] - point.Z() * hv[3]) / w);
+
+}
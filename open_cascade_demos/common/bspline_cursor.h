@@ -0,0 +1,182 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Cursors for the sequential sampling of B-Spline curves, surfaces and laws
+//
+//  Sampling loops visit the parameters in increasing order, but Geom_BSplineCurve::D0, Geom_BSplineSurface::D0 and
+//  Law_BSpline::Value locate the knot span of every parameter from scratch and evaluate the basis functions again.
+//  A cursor remembers the span of the last parameter and the polynomial of the B-Spline on that span:
+//
+//      - The span of the next parameter is found by walking forward from the last one (see bspline_basis.h), which
+//        costs one comparison per parameter while the parameter stays in the same span.
+//      - When the parameter enters a new span, the B-Spline on the span is converted to the power basis: the
+//        coefficients c[k] = C^(k)(U[s]) / k! of its Taylor polynomial at the start U[s] of the span are computed from
+//        the derivatives of the basis functions (and the tensor product of the coefficients of both directions for a
+//        surface).
+//      - Inside the span, the point and its derivatives are evaluated with the Horner scheme, in (degree+1) multiply
+//        and add operations per coordinate instead of the (degree+1)^2 operations of the basis functions.
+//
+//  The rational B-Splines are converted in homogeneous coordinates (the poles multiplied by their weights, followed by
+//  the weights) and the point is divided by the weight after the evaluation. The periodic B-Splines are copied and
+//  converted to their non-periodic form, and the parameters are brought into the first period.
+//
+//  The cursors hold a copy of the data of the B-Spline, so the curve, surface or law can be modified or released
+//  afterwards without changing the cursor. A cursor changes on every evaluation, so each thread needs its own cursor.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef BSPLINE_CURSOR_H
+#define BSPLINE_CURSOR_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Law_BSpline.hxx>
+
+
+// Include the shared demo library
+#include "bspline_surface_data.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a B-Spline of one parameter with poles of any dimension
+// ------------------------------------------------------------------------------------------------------------------ //
+class BSplineSpanCursor {
+
+public:
+
+    // knots: flat knot vector (number_of_poles + degree + 1 knots)
+    // poles: number_of_poles * dimension coordinates, stored pole after pole
+    BSplineSpanCursor(const std::vector<double> &knots, int degree, int dimension, const std::vector<double> &poles);
+
+    // Coordinates (and first derivatives, if requested) of the B-Spline at the parameter u (dimension values each)
+    void evaluate(double u, double *value, double *derivative = nullptr);
+
+    int degree() const { return degree_; }
+    int dimension() const { return dimension_; }
+    int number_of_poles() const { return number_of_poles_; }
+    double first_parameter() const { return knots_[degree_]; }
+    double last_parameter() const { return knots_[number_of_poles_]; }
+
+    // Number of times the power basis coefficients were computed (once per span entered)
+    std::size_t number_of_span_changes() const { return number_of_span_changes_; }
+
+private:
+
+    // Convert the B-Spline on the span to the power basis
+    void load_span(int span);
+
+    int degree_;
+    int dimension_;
+    int number_of_poles_;
+    std::vector<double> knots_;
+    std::vector<double> poles_;
+
+    // Current span, its first knot and the coefficients c[k * dimension + d] of its polynomial
+    int span_ = -1;
+    double span_start_ = 0.0;
+    std::vector<double> coefficients_;
+    std::size_t number_of_span_changes_ = 0;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Geom_BSplineCurve (same results as D0 and D1 up to rounding)
+// ------------------------------------------------------------------------------------------------------------------ //
+class BSplineCurveCursor {
+
+public:
+
+    explicit BSplineCurveCursor(const Handle(Geom_BSplineCurve) &curve);
+
+    gp_Pnt value(double u);
+    void d1(double u, gp_Pnt &point, gp_Vec &tangent);
+
+    const BSplineSpanCursor &span_cursor() const { return cursor_; }
+
+private:
+
+    static BSplineSpanCursor make_cursor(const Handle(Geom_BSplineCurve) &curve);
+
+    double periodic_parameter(double u) const;
+
+    bool is_rational_;
+    bool is_periodic_;
+    BSplineSpanCursor cursor_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Law_BSpline (same results as Value and D1 up to rounding)
+// ------------------------------------------------------------------------------------------------------------------ //
+class BSplineLawCursor {
+
+public:
+
+    explicit BSplineLawCursor(const Law_BSpline &law);
+
+    double value(double u);
+    void d1(double u, double &value, double &derivative);
+
+    const BSplineSpanCursor &span_cursor() const { return cursor_; }
+
+private:
+
+    static BSplineSpanCursor make_cursor(const Law_BSpline &law);
+
+    double periodic_parameter(double u) const;
+
+    bool is_rational_;
+    bool is_periodic_;
+    BSplineSpanCursor cursor_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cursor of a Geom_BSplineSurface (same results as D0 and D1 up to rounding)
+// The polynomial of the current pair of spans is kept, so the fastest sweeps keep one parameter in the same span
+// ------------------------------------------------------------------------------------------------------------------ //
+class BSplineSurfaceCursor {
+
+public:
+
+    explicit BSplineSurfaceCursor(const Handle(Geom_BSplineSurface) &surface);
+
+    gp_Pnt value(double u, double v);
+    void d1(double u, double v, gp_Pnt &point, gp_Vec &d1u, gp_Vec &d1v);
+
+    // Number of times the power basis coefficients were computed (once per pair of spans entered)
+    std::size_t number_of_patch_changes() const { return number_of_patch_changes_; }
+
+private:
+
+    // Homogeneous coordinates and their derivatives at (u, v)
+    void evaluate(double u, double v, double *value, double *d1u, double *d1v);
+
+    // Convert the B-Spline on the pair of spans to the power basis
+    void load_patch(int u_span, int v_span);
+
+    BSplineSurfaceData data_;
+
+    // Current pair of spans, their first knots and the coefficients c[(k * (v_degree+1) + l) * dimension + d]
+    int u_span_ = -1;
+    int v_span_ = -1;
+    double u_span_start_ = 0.0;
+    double v_span_start_ = 0.0;
+    std::vector<double> coefficients_;
+    std::size_t number_of_patch_changes_ = 0;
+
+};
+
+
+#endif //BSPLINE_CURSOR_H
@@ -0,0 +1,260 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Batch evaluation of B-Spline evolution laws (Law_BSpline) at many parameters
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+
+// Include OpenCascade libraries
+#include <TColStd_Array1OfReal.hxx>
+
+
+// Include the header of this module
+#include "bspline_law_evaluator.h"
+
+
+// Include the shared demo library
+#include "bspline_basis.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Data of the law read by the evaluation kernels (the weights are null if the law is not rational)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct LawKernel {
+    int degree;
+    const double *knots;
+    const double *poles;
+    const double *weights;
+    const double *pole_differences;
+    const double *weight_differences;
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Value and derivative at one parameter
+// ------------------------------------------------------------------------------------------------------------------ //
+static void evaluate_sample(const LawKernel &kernel, double u, int span, double *value, double *derivative) {
+
+    int p = kernel.degree;
+    double basis[MAX_BSPLINE_DEGREE + 1];
+    double lower_basis[MAX_BSPLINE_DEGREE + 1];
+    bspline_basis_functions(kernel.knots, span, p, u, basis, derivative != nullptr ? lower_basis : nullptr);
+
+    // The non-zero basis functions multiply the poles span-p, ..., span (and the derivative poles span-p, ..., span-1)
+    int first = span - p;
+    double a = 0.0, da = 0.0;
+    for (int j = 0; j <= p; ++j) { a += basis[j] * kernel.poles[first + j]; }
+    if (derivative != nullptr) {
+        for (int j = 0; j < p; ++j) { da += lower_basis[j] * kernel.pole_differences[first + j]; }
+    }
+    if (kernel.weights == nullptr) {
+        *value = a;
+        if (derivative != nullptr) { *derivative = da; }
+        return;
+    }
+
+    // Rational law: R = A / W and R' = (A' - R W') / W
+    double w = 0.0, dw = 0.0;
+    for (int j = 0; j <= p; ++j) { w += basis[j] * kernel.weights[first + j]; }
+    *value = a / w;
+    if (derivative != nullptr) {
+        for (int j = 0; j < p; ++j) { dw += lower_basis[j] * kernel.weight_differences[first + j]; }
+        *derivative = (da - *value * dw) / w;
+    }
+
+}
+
+
+#ifdef __AVX2__
+// ------------------------------------------------------------------------------------------------------------------ //
+// Load array[offset + index] for the four 32-bit indices of a vector (the masked form avoids an undefined source)
+// ------------------------------------------------------------------------------------------------------------------ //
+static inline __m256d gather(const double *array, __m128i index, int offset) {
+
+    __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    __m128i offset_index = _mm_add_epi32(index, _mm_set1_epi32(offset));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), array, offset_index, all_lanes, 8);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Values and derivatives at four parameters, one per lane (the same steps as evaluate_sample)
+// ------------------------------------------------------------------------------------------------------------------ //
+static void evaluate_block(const LawKernel &kernel, const double *u, const int *spans, double *values,
+                           double *derivatives) {
+
+    int p = kernel.degree;
+    __m256d parameter = _mm256_loadu_pd(u);
+    __m128i span = _mm_loadu_si128(reinterpret_cast<const __m128i *>(spans));
+
+    // Basis functions of the four spans
+    __m256d left[MAX_BSPLINE_DEGREE + 1];
+    __m256d right[MAX_BSPLINE_DEGREE + 1];
+    __m256d basis[MAX_BSPLINE_DEGREE + 1];
+    __m256d lower_basis[MAX_BSPLINE_DEGREE + 1];
+    basis[0] = _mm256_set1_pd(1.0);
+    lower_basis[0] = basis[0];
+    for (int j = 1; j <= p; ++j) {
+        left[j] = _mm256_sub_pd(parameter, gather(kernel.knots, span, 1 - j));
+        right[j] = _mm256_sub_pd(gather(kernel.knots, span, j), parameter);
+        __m256d saved = _mm256_setzero_pd();
+        for (int r = 0; r < j; ++r) {
+            __m256d temp = _mm256_div_pd(basis[r], _mm256_add_pd(right[r + 1], left[j - r]));
+            basis[r] = _mm256_add_pd(saved, _mm256_mul_pd(right[r + 1], temp));
+            saved = _mm256_mul_pd(left[j - r], temp);
+        }
+        basis[j] = saved;
+        if (j == p - 1) {
+            for (int r = 0; r <= j; ++r) { lower_basis[r] = basis[r]; }
+        }
+    }
+
+    // Sum of the basis functions times the coefficients gathered from the first pole of each span
+    __m128i first = _mm_sub_epi32(span, _mm_set1_epi32(p));
+    auto combine = [&first](const double *coefficients, const __m256d *functions, int count) {
+        __m256d sum = _mm256_setzero_pd();
+        for (int j = 0; j < count; ++j) {
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(functions[j], gather(coefficients, first, j)));
+        }
+        return sum;
+    };
+
+    __m256d a = combine(kernel.poles, basis, p + 1);
+    if (kernel.weights == nullptr) {
+        _mm256_storeu_pd(values, a);
+        if (derivatives != nullptr) { _mm256_storeu_pd(derivatives, combine(kernel.pole_differences, lower_basis, p)); }
+        return;
+    }
+
+    // Rational law
+    __m256d w = combine(kernel.weights, basis, p + 1);
+    __m256d value = _mm256_div_pd(a, w);
+    _mm256_storeu_pd(values, value);
+    if (derivatives != nullptr) {
+        __m256d da = combine(kernel.pole_differences, lower_basis, p);
+        __m256d dw = combine(kernel.weight_differences, lower_basis, p);
+        _mm256_storeu_pd(derivatives, _mm256_div_pd(_mm256_sub_pd(da, _mm256_mul_pd(value, dw)), w));
+    }
+
+}
+#endif
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Copy the data of the law
+// ------------------------------------------------------------------------------------------------------------------ //
+BSplineLawEvaluator::BSplineLawEvaluator(const Law_BSpline &law) :
+        degree_(law.Degree()), number_of_poles_(law.NbPoles()), is_rational_(law.IsRational()) {
+
+    // The flat knots of the periodic laws are not clamped, so these are left to Law_BSpline
+    if (law.IsPeriodic()) {
+        periodic_law_ = law.Copy();
+        return;
+    }
+
+    int n = number_of_poles_, p = degree_;
+    TColStd_Array1OfReal knots(1, n + p + 1);
+    law.KnotSequence(knots);
+    knots_.assign(&knots(1), &knots(1) + knots.Length());
+
+    TColStd_Array1OfReal poles(1, n);
+    law.Poles(poles);
+    poles_.assign(&poles(1), &poles(1) + n);
+    if (is_rational_) {
+        TColStd_Array1OfReal weights(1, n);
+        law.Weights(weights);
+        weights_.assign(&weights(1), &weights(1) + n);
+        for (int i = 0; i < n; ++i) { poles_[i] *= weights_[i]; }
+    }
+
+    // Poles of the derivative (the spans of zero length give no contribution)
+    pole_differences_.assign(size_t(n - 1), 0.0);
+    weight_differences_.assign(is_rational_ ? size_t(n - 1) : 0, 0.0);
+    for (int i = 0; i < n - 1; ++i) {
+        double length = knots_[i + p + 1] - knots_[i + 1];
+        if (length <= 0.0) { continue; }
+        pole_differences_[i] = p * (poles_[i + 1] - poles_[i]) / length;
+        if (is_rational_) { weight_differences_[i] = p * (weights_[i + 1] - weights_[i]) / length; }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Evaluate the law
+// ------------------------------------------------------------------------------------------------------------------ //
+void BSplineLawEvaluator::evaluate(const double *parameters, size_t count, double *values,
+                                   double *derivatives) const {
+
+    if (!periodic_law_.IsNull()) {
+        for (size_t i = 0; i < count; ++i) {
+            if (derivatives != nullptr) { periodic_law_->D1(parameters[i], values[i], derivatives[i]); }
+            else { values[i] = periodic_law_->Value(parameters[i]); }
+        }
+        return;
+    }
+
+    LawKernel kernel = {degree_, knots_.data(), poles_.data(), is_rational_ ? weights_.data() : nullptr,
+                        pole_differences_.data(), weight_differences_.data()};
+    int span = degree_;
+    size_t i = 0;
+
+#ifdef __AVX2__
+    // Blocks of four parameters, with their spans found one after the other
+    int spans[4];
+    for (; i + 4 <= count; i += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            span = find_bspline_span(kernel.knots, number_of_poles_, degree_, parameters[i + lane], span);
+            spans[lane] = span;
+        }
+        evaluate_block(kernel, parameters + i, spans, values + i, derivatives != nullptr ? derivatives + i : nullptr);
+    }
+#endif
+
+    // Remaining parameters (all of them without AVX2)
+    for (; i < count; ++i) {
+        span = find_bspline_span(kernel.knots, number_of_poles_, degree_, parameters[i], span);
+        evaluate_sample(kernel, parameters[i], span, values + i, derivatives != nullptr ? derivatives + i : nullptr);
+    }
+
+}
+
+
+void BSplineLawEvaluator::evaluate(const vector<double> &parameters, vector<double> &values) const {
+
+    values.resize(parameters.size());
+    evaluate(parameters.data(), parameters.size(), values.data());
+
+}
+
+
+void BSplineLawEvaluator::evaluate(const vector<double> &parameters, vector<double> &values,
+                                   vector<double> &derivatives) const {
+
+    values.resize(parameters.size());
+    derivatives.resize(parameters.size());
+    evaluate(parameters.data(), parameters.size(), values.data(), derivatives.data());
+
+}
+
+
+const char *BSplineLawEvaluator::instruction_set() {
+
+#ifdef __AVX2__
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+
+}
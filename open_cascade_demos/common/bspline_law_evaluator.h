@@ -0,0 +1,89 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Batch evaluation of B-Spline evolution laws (Law_BSpline) at many parameters
+//
+//  Law_BSpline::Value locates the knot span of every parameter with a search over the knots and evaluates the
+//  B-Spline through several layers of generic code, one parameter at a time. The evaluator copies the poles, weights
+//  and flat knots of the law once and evaluates whole arrays of parameters:
+//
+//      - The knot spans are found by walking forward from the span of the previous parameter, so a sorted array of
+//        parameters costs one comparison per parameter (unsorted arrays fall back to a binary search).
+//      - The basis functions are computed with the triangular scheme of The NURBS Book (see bspline_basis.h), whose
+//        steps only depend on the degree. When the library is compiled with AVX2 (DEMO_COMMON_NATIVE_ARCH, see
+//        CMakeLists.txt), four parameters go through the scheme at once, each in one lane of a vector register, and
+//        the knots and poles of the four spans are gathered from memory. Otherwise the same scheme runs one parameter
+//        at a time.
+//      - The first derivative is the B-Spline of degree p-1 of the differences of the poles, and its basis functions
+//        are an intermediate step of the scheme, so the derivative costs little more than the value.
+//
+//  The results are equal to those of Law_BSpline::Value and Law_BSpline::D1 up to rounding, which differs because the
+//  terms are summed in another order. The tolerance is on the scale of one ulp of the law: the largest difference is
+//  at most MAX_LAW_ERROR_IN_ULPS times the machine epsilon times the largest magnitude of the values (and of the
+//  derivatives for D1), which benchmark_bspline_law checks. The periodic laws are evaluated with Law_BSpline::D1 for
+//  every parameter.
+//
+//  The evaluator takes a copy of the law: modifying the law afterwards (SetPole, ...) does not change the evaluator.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef BSPLINE_LAW_EVALUATOR_H
+#define BSPLINE_LAW_EVALUATOR_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Law_BSpline.hxx>
+
+
+// Largest difference with Law_BSpline, in units of the machine epsilon times the largest magnitude of the results
+const double MAX_LAW_ERROR_IN_ULPS = 8.0;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Batch evaluator of a B-Spline law
+// ------------------------------------------------------------------------------------------------------------------ //
+class BSplineLawEvaluator {
+
+public:
+
+    explicit BSplineLawEvaluator(const Law_BSpline &law);
+
+    // Values (and first derivatives, if requested) of the law at count parameters, preferably sorted
+    void evaluate(const double *parameters, std::size_t count, double *values, double *derivatives = nullptr) const;
+    void evaluate(const std::vector<double> &parameters, std::vector<double> &values) const;
+    void evaluate(const std::vector<double> &parameters, std::vector<double> &values,
+                  std::vector<double> &derivatives) const;
+
+    int degree() const { return degree_; }
+    int number_of_poles() const { return number_of_poles_; }
+    bool is_rational() const { return is_rational_; }
+
+    // Instruction set used by the batch evaluation ("AVX2" or "scalar")
+    static const char *instruction_set();
+
+private:
+
+    int degree_;
+    int number_of_poles_;
+    bool is_rational_;
+
+    // Flat knots, poles (multiplied by their weights if the law is rational) and weights
+    std::vector<double> knots_;
+    std::vector<double> poles_;
+    std::vector<double> weights_;
+
+    // Poles of the derivative: p * (P[i+1] - P[i]) / (U[i+p+1] - U[i+1]), and the same for the weights
+    std::vector<double> pole_differences_;
+    std::vector<double> weight_differences_;
+
+    // Copy of the law, only for the periodic laws
+    Handle(Law_BSpline) periodic_law_;
+
+};
+
+
+#endif //BSPLINE_LAW_EVALUATOR_H
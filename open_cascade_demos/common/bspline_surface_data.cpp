@@ -0,0 +1,97 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Flat copy of the data of a Geom_BSplineSurface for the evaluators of the shared demo library
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include OpenCascade libraries
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+
+
+// Include the header of this module
+#include "bspline_surface_data.h"
+
+
+// Include the shared demo library
+#include "bspline_basis.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Copy the data of the surface
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Copy of the surface with its periodic directions converted to their non-periodic form (the surface if there is none)
+static Handle(Geom_BSplineSurface) non_periodic_surface(const Handle(Geom_BSplineSurface) &surface) {
+
+    if (!surface->IsUPeriodic() && !surface->IsVPeriodic()) { return surface; }
+    Handle(Geom_BSplineSurface) clamped = Handle(Geom_BSplineSurface)::DownCast(surface->Copy());
+    if (surface->IsUPeriodic()) { clamped->SetUNotPeriodic(); }
+    if (surface->IsVPeriodic()) { clamped->SetVNotPeriodic(); }
+    return clamped;
+
+}
+
+
+// Control net of the poles in homogeneous coordinates, with one row of the net per u pole
+static ControlNet homogeneous_poles(const Handle(Geom_BSplineSurface) &surface) {
+
+    TColgp_Array2OfPnt surface_poles(1, surface->NbUPoles(), 1, surface->NbVPoles());
+    surface->Poles(surface_poles);
+    if (!surface->IsURational() && !surface->IsVRational()) { return ControlNet(surface_poles); }
+
+    // The weights are copied as they are and the coordinates are multiplied by them
+    TColStd_Array2OfReal weights(1, surface->NbUPoles(), 1, surface->NbVPoles());
+    surface->Weights(weights);
+    ControlNet net(surface_poles, weights);
+    const double *w = net.w();
+    for (int d = 0; d < 3; ++d) {
+        double *coordinate = net.coordinate(d);
+        for (int k = 0; k < net.size(); ++k) { coordinate[k] *= w[k]; }
+    }
+    return net;
+
+}
+
+
+BSplineSurfaceData::BSplineSurfaceData(const Handle(Geom_BSplineSurface) &surface) :
+        BSplineSurfaceData(non_periodic_surface(surface), surface->IsUPeriodic(), surface->IsVPeriodic()) {}
+
+
+BSplineSurfaceData::BSplineSurfaceData(const Handle(Geom_BSplineSurface) &clamped, bool u_periodic, bool v_periodic) :
+        is_u_periodic(u_periodic), is_v_periodic(v_periodic), poles(homogeneous_poles(clamped)) {
+
+    u_degree = clamped->UDegree();
+    v_degree = clamped->VDegree();
+    number_of_u_poles = clamped->NbUPoles();
+    number_of_v_poles = clamped->NbVPoles();
+    dimension = poles.is_rational() ? 4 : 3;
+
+    TColStd_Array1OfReal flat_u_knots(1, number_of_u_poles + u_degree + 1);
+    TColStd_Array1OfReal flat_v_knots(1, number_of_v_poles + v_degree + 1);
+    clamped->UKnotSequence(flat_u_knots);
+    clamped->VKnotSequence(flat_v_knots);
+    u_knots.assign(&flat_u_knots(1), &flat_u_knots(1) + flat_u_knots.Length());
+    v_knots.assign(&flat_v_knots(1), &flat_v_knots(1) + flat_v_knots.Length());
+
+}
+
+
+double BSplineSurfaceData::wrap_u(double u) const {
+
+    return is_u_periodic ? wrap_periodic_parameter(u, u_knots[u_degree], u_knots[number_of_u_poles]) : u;
+
+}
+
+
+double BSplineSurfaceData::wrap_v(double v) const {
+
+    return is_v_periodic ? wrap_periodic_parameter(v, v_knots[v_degree], v_knots[number_of_v_poles]) : v;
+
+}
@@ -0,0 +1,66 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Flat copy of the data of a Geom_BSplineSurface for the evaluators of the shared demo library
+//
+//  The evaluators (see bspline_cursor.h and surface_grid_evaluator.h) read the knots and poles of the surface from
+//  plain arrays with zero-based indices instead of going through the accessors of Geom_BSplineSurface:
+//
+//      - The flat knot vectors of both directions (see bspline_basis.h).
+//      - The poles in homogeneous coordinates (x w, y w, z w, w) for the rational surfaces and (x, y, z) otherwise,
+//        in a control net with one row per u pole (see control_net.h): coordinate d of the pole (i, j) is
+//        poles.coordinate(d)[i * number_of_v_poles + j], and the fourth array holds the weights.
+//
+//  The periodic directions are converted to their non-periodic form on a copy of the surface, and the parameters are
+//  brought into the first period with wrap_u and wrap_v.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef BSPLINE_SURFACE_DATA_H
+#define BSPLINE_SURFACE_DATA_H
+
+
+// Include standard C++ libraries
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Geom_BSplineSurface.hxx>
+
+
+// Include the shared demo library
+#include "control_net.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Knots and poles of a B-Spline surface
+// ------------------------------------------------------------------------------------------------------------------ //
+struct BSplineSurfaceData {
+
+    explicit BSplineSurfaceData(const Handle(Geom_BSplineSurface) &surface);
+
+    int u_degree;
+    int v_degree;
+    int number_of_u_poles;
+    int number_of_v_poles;
+    int dimension;                      // 4 for the rational surfaces (homogeneous coordinates), 3 otherwise
+    bool is_u_periodic;
+    bool is_v_periodic;
+    std::vector<double> u_knots;
+    std::vector<double> v_knots;
+    ControlNet poles;                   // Homogeneous coordinates (the x, y and z arrays are multiplied by the weights)
+
+    bool is_rational() const { return dimension == 4; }
+
+    // Parameters brought into the first period of the periodic directions (unchanged otherwise)
+    double wrap_u(double u) const;
+    double wrap_v(double v) const;
+
+private:
+
+    // Copy the data of the non-periodic form of a surface whose directions were periodic as given
+    BSplineSurfaceData(const Handle(Geom_BSplineSurface) &clamped, bool u_periodic, bool v_periodic);
+
+};
+
+
+#endif //BSPLINE_SURFACE_DATA_H
@@ -0,0 +1,259 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Control net of a B-Spline curve or surface stored as a structure of arrays
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+
+// Include OpenCascade libraries
+#include <Standard.hxx>
+
+
+// Include the header of this module
+#include "control_net.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Construction and destruction
+// ------------------------------------------------------------------------------------------------------------------ //
+ControlNet::ControlNet(int number_of_rows, int number_of_columns, bool rational) {
+
+    allocate(number_of_rows, number_of_columns, rational);
+    fill(data_, data_ + 3 * stride_, 0.0);
+    if (rational_) { fill(w(), w() + size(), 1.0); }
+
+}
+
+
+ControlNet::ControlNet(const TColgp_Array1OfPnt &poles) {
+
+    allocate(poles.Length(), 1, false);
+    copy_points_from(&poles(poles.Lower()), size_t(size()), 0);
+
+}
+
+
+ControlNet::ControlNet(const TColgp_Array1OfPnt &poles, const TColStd_Array1OfReal &weights) {
+
+    if (weights.Length() != poles.Length()) { throw invalid_argument("ControlNet: poles and weights differ in size"); }
+    allocate(poles.Length(), 1, true);
+    copy_points_from(&poles(poles.Lower()), size_t(size()), 0);
+    copy(&weights(weights.Lower()), &weights(weights.Lower()) + size(), w());
+
+}
+
+
+ControlNet::ControlNet(const TColgp_Array2OfPnt &poles) {
+
+    // The rows of an NCollection_Array2 are stored one after the other, like the rows of the net
+    allocate(poles.ColLength(), poles.RowLength(), false);
+    copy_points_from(&poles(poles.LowerRow(), poles.LowerCol()), size_t(size()), 0);
+
+}
+
+
+ControlNet::ControlNet(const TColgp_Array2OfPnt &poles, const TColStd_Array2OfReal &weights) {
+
+    if (weights.ColLength() != poles.ColLength() || weights.RowLength() != poles.RowLength()) {
+        throw invalid_argument("ControlNet: poles and weights differ in size");
+    }
+    allocate(poles.ColLength(), poles.RowLength(), true);
+    copy_points_from(&poles(poles.LowerRow(), poles.LowerCol()), size_t(size()), 0);
+    const double *first_weight = &weights(weights.LowerRow(), weights.LowerCol());
+    copy(first_weight, first_weight + size(), w());
+
+}
+
+
+ControlNet::ControlNet(ControlNet &&other) :
+        number_of_rows_(other.number_of_rows_), number_of_columns_(other.number_of_columns_),
+        rational_(other.rational_), stride_(other.stride_), data_(other.data_) {
+
+    other.number_of_rows_ = 0;
+    other.number_of_columns_ = 0;
+    other.stride_ = 0;
+    other.data_ = nullptr;
+
+}
+
+
+ControlNet &ControlNet::operator=(ControlNet &&other) {
+
+    if (this != &other) {
+        Standard::FreeAligned(data_);
+        number_of_rows_ = other.number_of_rows_;
+        number_of_columns_ = other.number_of_columns_;
+        rational_ = other.rational_;
+        stride_ = other.stride_;
+        data_ = other.data_;
+        other.number_of_rows_ = 0;
+        other.number_of_columns_ = 0;
+        other.stride_ = 0;
+        other.data_ = nullptr;
+    }
+    return *this;
+
+}
+
+
+ControlNet::~ControlNet() {
+
+    Standard::FreeAligned(data_);
+
+}
+
+
+void ControlNet::allocate(int number_of_rows, int number_of_columns, bool rational) {
+
+    if (number_of_rows <= 0 || number_of_columns <= 0) { throw invalid_argument("ControlNet: empty control net"); }
+    number_of_rows_ = number_of_rows;
+    number_of_columns_ = number_of_columns;
+    rational_ = rational;
+
+    // Round the length of each array up to a whole number of 64-byte blocks so that every array starts aligned
+    const size_t values_per_block = ALIGNMENT / sizeof(double);
+    stride_ = (size_t(size()) + values_per_block - 1) / values_per_block * values_per_block;
+    size_t number_of_arrays = rational ? 4 : 3;
+    data_ = static_cast<double *>(Standard::AllocateAligned(number_of_arrays * stride_ * sizeof(double), ALIGNMENT));
+    if (data_ == nullptr) { throw bad_alloc(); }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Single poles and weights
+// ------------------------------------------------------------------------------------------------------------------ //
+gp_Pnt ControlNet::pole(int i, int j) const {
+
+    size_t k = index(i, j);
+    return gp_Pnt(x()[k], y()[k], z()[k]);
+
+}
+
+
+void ControlNet::set_pole(int i, int j, const gp_Pnt &point) {
+
+    size_t k = index(i, j);
+    x()[k] = point.X();
+    y()[k] = point.Y();
+    z()[k] = point.Z();
+
+}
+
+
+void ControlNet::set_weight(int i, int j, double value) {
+
+    if (!rational_) { throw invalid_argument("ControlNet: the control net has no weights"); }
+    w()[index(i, j)] = value;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Zero-copy views
+// ------------------------------------------------------------------------------------------------------------------ //
+TColStd_Array1OfReal ControlNet::view(int d) {
+
+    if (d < 0 || d > (rational_ ? 3 : 2)) { throw invalid_argument("ControlNet: no array with this index"); }
+    return TColStd_Array1OfReal(*coordinate(d), 1, size());
+
+}
+
+
+TColStd_Array2OfReal ControlNet::view_2d(int d) {
+
+    if (d < 0 || d > (rational_ ? 3 : 2)) { throw invalid_argument("ControlNet: no array with this index"); }
+    return TColStd_Array2OfReal(*coordinate(d), 1, number_of_rows_, 1, number_of_columns_);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Bulk copies
+// ------------------------------------------------------------------------------------------------------------------ //
+void ControlNet::copy_points_from(const gp_Pnt *points, size_t count, size_t first) {
+
+    double *px = x() + first, *py = y() + first, *pz = z() + first;
+    for (size_t k = 0; k < count; ++k) {
+        px[k] = points[k].X();
+        py[k] = points[k].Y();
+        pz[k] = points[k].Z();
+    }
+
+}
+
+
+void ControlNet::copy_points_to(gp_Pnt *points, size_t count, size_t first) const {
+
+    const double *px = x() + first, *py = y() + first, *pz = z() + first;
+    for (size_t k = 0; k < count; ++k) { points[k].SetCoord(px[k], py[k], pz[k]); }
+
+}
+
+
+void ControlNet::copy_poles_to(TColgp_Array1OfPnt &poles) const {
+
+    if (poles.Length() != size()) { throw invalid_argument("ControlNet: the pole array differs in size"); }
+    copy_points_to(&poles(poles.Lower()), size_t(size()), 0);
+
+}
+
+
+void ControlNet::copy_poles_to(TColgp_Array2OfPnt &poles) const {
+
+    if (poles.ColLength() != number_of_rows_ || poles.RowLength() != number_of_columns_) {
+        throw invalid_argument("ControlNet: the pole array differs in size");
+    }
+    copy_points_to(&poles(poles.LowerRow(), poles.LowerCol()), size_t(size()), 0);
+
+}
+
+
+void ControlNet::copy_weights_to(TColStd_Array1OfReal &weights) const {
+
+    if (weights.Length() != size()) { throw invalid_argument("ControlNet: the weight array differs in size"); }
+    double *first_weight = &weights(weights.Lower());
+    if (rational_) { copy(w(), w() + size(), first_weight); }
+    else { fill(first_weight, first_weight + size(), 1.0); }
+
+}
+
+
+void ControlNet::copy_weights_to(TColStd_Array2OfReal &weights) const {
+
+    if (weights.ColLength() != number_of_rows_ || weights.RowLength() != number_of_columns_) {
+        throw invalid_argument("ControlNet: the weight array differs in size");
+    }
+    double *first_weight = &weights(weights.LowerRow(), weights.LowerCol());
+    if (rational_) { copy(w(), w() + size(), first_weight); }
+    else { fill(first_weight, first_weight + size(), 1.0); }
+
+}
+
+
+TColgp_Array1OfPnt ControlNet::poles_1d() const {
+
+    TColgp_Array1OfPnt poles(1, size());
+    copy_poles_to(poles);
+    return poles;
+
+}
+
+
+TColgp_Array2OfPnt ControlNet::poles_2d() const {
+
+    TColgp_Array2OfPnt poles(1, number_of_rows_, 1, number_of_columns_);
+    copy_poles_to(poles);
+    return poles;
+
+}
@@ -0,0 +1,132 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Control net of a B-Spline curve or surface stored as a structure of arrays
+//
+//  TColgp_Array1OfPnt and TColgp_Array2OfPnt store the poles as gp_Pnt objects (x, y and z side by side) with
+//  one-based indices, and the weights live in a separate TColStd array. A kernel that processes one coordinate of
+//  many poles at a time (a SIMD loop, for instance) has to gather that coordinate with a stride of three values. The
+//  control net stores the poles as separate x, y and z arrays, followed by the weights for the rational nets:
+//
+//      - The four arrays live in a single allocation, and each one starts on a 64-byte boundary (a cache line, and the
+//        width of an AVX-512 register), so they can be read with aligned vector loads.
+//      - The pole (i, j) of a net with n columns is the element i * n + j of every array (zero-based indices, rows
+//        first, the same order as the rows and columns of a TColgp_Array2OfPnt). Curves are nets with one column.
+//
+//  The conversions to and from the OpenCascade arrays never copy more than needed:
+//
+//      - Zero-copy: each array (a single coordinate or the weights) can be seen as a TColStd_Array1OfReal or
+//        TColStd_Array2OfReal that borrows the memory of the net, through the NCollection constructors that take the
+//        first element of an existing buffer. The views can be passed to the constructors of Geom_BSplineCurve,
+//        Geom_BSplineSurface and Law_BSpline, and writing through them modifies the net. A view must not outlive the
+//        net, and it cannot be resized.
+//      - Single bulk copy: a gp_Pnt array has no layout in common with separate coordinate arrays, so the poles are
+//        copied in one pass over contiguous memory in each direction.
+//
+//  BSplineSurfaceData (see bspline_surface_data.h) keeps the poles of the surfaces in a control net, so the row
+//  contractions of the grid evaluator and of the surface cursor run over contiguous arrays of a single coordinate.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef CONTROL_NET_H
+#define CONTROL_NET_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Poles (and weights) of a control net as separate 64-byte aligned arrays
+// ------------------------------------------------------------------------------------------------------------------ //
+class ControlNet {
+
+public:
+
+    // Alignment of the arrays in bytes
+    static const std::size_t ALIGNMENT = 64;
+
+    // Net of number_of_rows x number_of_columns poles at the origin (with unit weights if it is rational)
+    // The constructors and copies throw std::invalid_argument for empty nets and arrays of a different size
+    ControlNet(int number_of_rows, int number_of_columns = 1, bool rational = false);
+
+    // Copy the poles (and weights) of the OpenCascade arrays in a single pass
+    explicit ControlNet(const TColgp_Array1OfPnt &poles);
+    ControlNet(const TColgp_Array1OfPnt &poles, const TColStd_Array1OfReal &weights);
+    explicit ControlNet(const TColgp_Array2OfPnt &poles);
+    ControlNet(const TColgp_Array2OfPnt &poles, const TColStd_Array2OfReal &weights);
+
+    // The arrays are owned by the net, which can be moved but not copied
+    ControlNet(ControlNet &&other);
+    ControlNet &operator=(ControlNet &&other);
+    ControlNet(const ControlNet &) = delete;
+    ControlNet &operator=(const ControlNet &) = delete;
+    ~ControlNet();
+
+    int number_of_rows() const { return number_of_rows_; }
+    int number_of_columns() const { return number_of_columns_; }
+    int size() const { return number_of_rows_ * number_of_columns_; }
+    bool is_rational() const { return rational_; }
+
+    // Coordinate arrays (d = 0, 1, 2 for x, y, z) and weights (null for the non-rational nets)
+    double *coordinate(int d) { return data_ + std::size_t(d) * stride_; }
+    const double *coordinate(int d) const { return data_ + std::size_t(d) * stride_; }
+    double *x() { return coordinate(0); }
+    double *y() { return coordinate(1); }
+    double *z() { return coordinate(2); }
+    double *w() { return rational_ ? coordinate(3) : nullptr; }
+    const double *x() const { return coordinate(0); }
+    const double *y() const { return coordinate(1); }
+    const double *z() const { return coordinate(2); }
+    const double *w() const { return rational_ ? coordinate(3) : nullptr; }
+
+    // Access to a single pole and weight with zero-based indices (prefer the arrays in loops)
+    gp_Pnt pole(int i, int j = 0) const;
+    void set_pole(int i, int j, const gp_Pnt &point);
+    double weight(int i, int j = 0) const { return rational_ ? w()[index(i, j)] : 1.0; }
+    void set_weight(int i, int j, double value);
+
+    // Zero-copy views with one-based indices (1..size, or 1..rows x 1..columns) over an array of the net
+    // d = 0, 1, 2 selects a coordinate and d = 3 the weights of a rational net
+    // The views can write to the net, so they are only available on non-const nets (use the bulk copies otherwise)
+    TColStd_Array1OfReal view(int d);
+    TColStd_Array2OfReal view_2d(int d);
+
+    // Bulk copies to OpenCascade arrays of the same size (any lower bounds)
+    void copy_poles_to(TColgp_Array1OfPnt &poles) const;
+    void copy_poles_to(TColgp_Array2OfPnt &poles) const;
+    void copy_weights_to(TColStd_Array1OfReal &weights) const;
+    void copy_weights_to(TColStd_Array2OfReal &weights) const;
+
+    // New OpenCascade pole arrays with one-based indices (filled with a bulk copy)
+    TColgp_Array1OfPnt poles_1d() const;
+    TColgp_Array2OfPnt poles_2d() const;
+
+private:
+
+    std::size_t index(int i, int j) const { return std::size_t(i) * std::size_t(number_of_columns_) + std::size_t(j); }
+
+    // Allocate the arrays of the net (the values are not initialised)
+    void allocate(int number_of_rows, int number_of_columns, bool rational);
+
+    // Copy the coordinates of contiguous gp_Pnt objects into the arrays, starting at the pole with the given index
+    void copy_points_from(const gp_Pnt *points, std::size_t count, std::size_t first);
+    void copy_points_to(gp_Pnt *points, std::size_t count, std::size_t first) const;
+
+    int number_of_rows_ = 0;
+    int number_of_columns_ = 0;
+    bool rational_ = false;
+    std::size_t stride_ = 0;            // Distance between the starts of two arrays (a multiple of 8 values)
+    double *data_ = nullptr;
+
+};
+
+
+#endif //CONTROL_NET_H
@@ -0,0 +1,71 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Access to the models exported by the demonstration scripts
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <iostream>
+
+
+// Include OpenCascade libraries
+#include <STEPControl_Reader.hxx>
+
+
+// Include the header of this module
+#include "demo_models.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read a .step file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool read_step_file(const string &file_name, TopoDS_Shape &model_object) {
+
+    STEPControl_Reader step_reader;
+    if (step_reader.ReadFile(file_name.c_str()) != IFSelect_RetDone) { return false; }
+    if (step_reader.TransferRoots() == 0) { return false; }
+    model_object = step_reader.OneShape();
+    return !model_object.IsNull();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read the models of all the demonstration scripts
+// ------------------------------------------------------------------------------------------------------------------ //
+vector<DemoModel> load_demo_models(const string &demos_path) {
+
+    // Demonstration project and name of the .step file that it writes
+    const char *const demo_files[][2] = {
+            {"open_cascade_minimal_working_example", "minimal_working_example"},
+            {"demo_bezier_curve",                    "bezier_curve"},
+            {"demo_bezier_surface",                  "bezier_surface"},
+            {"demo_bezier_surface_rational",         "bezier_rational_surface"},
+            {"demo_bspline_curve",                   "bspline_curve"},
+            {"demo_bspline_curve_extended",          "bspline_curve"},
+            {"demo_circle",                          "circle"},
+            {"demo_coons_surface_2boundaries",       "coons_surface"},
+            {"demo_coons_surface_3boundaries",       "coons_surface"},
+            {"demo_coons_surface_4boundaries",       "coons_surface"},
+            {"demo_nurbs_surface",                   "nurbs_surface"},
+            {"demo_perforated_disk",                 "perforated_disk"},
+            {"demo_ruled_surface",                   "ruled_surface"},
+            {"demo_square",                          "square"},
+    };
+
+    vector<DemoModel> models;
+    for (const auto &demo_file : demo_files) {
+        DemoModel model;
+        model.demo_name = demo_file[0];
+        model.step_file_name = demos_path + demo_file[0] + "/output/" + demo_file[1] + ".step";
+        if (read_step_file(model.step_file_name, model.model_object)) { models.push_back(model); }
+        else { cerr << "Skipping " << model.demo_name << ": cannot read " << model.step_file_name << endl; }
+    }
+    return models;
+
+}
@@ -0,0 +1,38 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Access to the models exported by the demonstration scripts (used by the benchmark projects)
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef DEMO_MODELS_H
+#define DEMO_MODELS_H
+
+
+// Include standard C++ libraries
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Model exported by one of the demonstration scripts
+// ------------------------------------------------------------------------------------------------------------------ //
+struct DemoModel {
+    std::string demo_name;          // Name of the demonstration project (for instance demo_perforated_disk)
+    std::string step_file_name;     // Path to the .step file written by the demonstration script
+    TopoDS_Shape model_object;      // Shape read from the .step file
+};
+
+
+// Read a .step file and return its content as a single shape (returns false if the file cannot be read)
+bool read_step_file(const std::string &file_name, TopoDS_Shape &model_object);
+
+// Read the models of all the demonstration scripts from <demos_path><demo_name>/output/
+// Models that cannot be read (for instance because the demo was never run) are skipped with a message on cerr
+std::vector<DemoModel> load_demo_models(const std::string &demos_path = "../../");
+
+
+#endif //DEMO_MODELS_H
@@ -0,0 +1,149 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Content-addressed cache of exported models
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+// Include the header of this module
+#include "export_cache.h"
+#include "brep_cache.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Version of the layout of the cache (changing it invalidates all the cached files)
+static const int EXPORT_CACHE_VERSION = 1;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// File system helpers
+// ------------------------------------------------------------------------------------------------------------------ //
+static bool file_exists(const string &file_name, struct stat &file_status) {
+
+    return stat(file_name.c_str(), &file_status) == 0 && S_ISREG(file_status.st_mode);
+
+}
+
+
+// Make target refer to the same content as source (hard link if possible, copy otherwise)
+static bool link_or_copy(const string &source, const string &target) {
+
+    // Never write through an existing file: it may be a hard link to a cached file
+    remove(target.c_str());
+    if (link(source.c_str(), target.c_str()) == 0) { return true; }
+
+    // Copy into a temporary file and rename it, so that a partial copy is never visible
+    string temporary = target + ".tmp";
+    {
+        ifstream input(source, ios::binary);
+        ofstream output(temporary, ios::binary);
+        output << input.rdbuf();
+        if (!input || !output) {
+            remove(temporary.c_str());
+            return false;
+        }
+    }
+    return rename(temporary.c_str(), target.c_str()) == 0;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Directory of the cache
+// ------------------------------------------------------------------------------------------------------------------ //
+string default_export_cache_path() {
+
+    const char *cache_path = getenv("DEMO_EXPORT_CACHE");
+    if (cache_path == nullptr || *cache_path == '\0') { return "../cache/"; }
+    string path(cache_path);
+    return path[path.size() - 1] == '/' ? path : path + "/";
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cache of the files written by a StepExporter
+// ------------------------------------------------------------------------------------------------------------------ //
+ExportCache::ExportCache(const StepExporter &step_exporter, const string &cache_path) : cache_path_(cache_path) {
+
+    // Hash the settings of the exporter that change the content of the files
+    ModelHasher settings;
+    settings.add(EXPORT_CACHE_VERSION).add(int(step_exporter.step_mode())).add(step_exporter.time_stamp());
+    settings.add(int(step_exporter.write_brep_cache()));
+    settings_digest_ = settings.hex_digest();
+
+    // Files written by the exporter for each model
+    extensions_.push_back(".step");
+    if (step_exporter.write_brep_cache()) { extensions_.push_back(BREP_CACHE_EXTENSION); }
+
+}
+
+
+string ExportCache::key(const ModelHasher &model_inputs) const {
+
+    return model_inputs.hex_digest() + "-" + settings_digest_;
+
+}
+
+
+bool ExportCache::fetch(const string &key, const string &relative_path, const string &model_name) {
+
+    struct stat cached_status, output_status;
+
+    // Check that every file of the model is in the cache
+    bool is_cached = true;
+    for (const string &extension : extensions_) {
+        is_cached = is_cached && file_exists(cache_path_ + key + extension, cached_status);
+    }
+
+    // On a miss, remove the old output files so that the new export does not write through a link into the cache
+    if (!is_cached) {
+        for (const string &extension : extensions_) { remove((relative_path + model_name + extension).c_str()); }
+        number_of_misses_++;
+        return false;
+    }
+
+    // Link the cached files into the output directory (nothing to do if they are already linked)
+    mkdir(relative_path.c_str(), 0777);     // 0777 is used to give the user permissions to read+write+execute
+    for (const string &extension : extensions_) {
+        string cached_file = cache_path_ + key + extension;
+        string output_file = relative_path + model_name + extension;
+        file_exists(cached_file, cached_status);
+        bool is_linked = file_exists(output_file, output_status) && output_status.st_ino == cached_status.st_ino &&
+                         output_status.st_dev == cached_status.st_dev;
+        if (!is_linked && !link_or_copy(cached_file, output_file)) {
+            number_of_misses_++;
+            return false;
+        }
+    }
+
+    number_of_hits_++;
+    return true;
+
+}
+
+
+bool ExportCache::store(const string &key, const string &relative_path, const string &model_name) {
+
+    // Create the cache directory if it does not exist
+    mkdir(cache_path_.c_str(), 0777);       // 0777 is used to give the user permissions to read+write+execute
+
+    // Add every file of the model to the cache
+    bool is_done = true;
+    for (const string &extension : extensions_) {
+        is_done = is_done && link_or_copy(relative_path + model_name + extension, cache_path_ + key + extension);
+    }
+    return is_done;
+
+}
@@ -0,0 +1,66 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Content-addressed cache of exported models
+//
+//  The key of a model is the hash of its inputs (see ModelHasher) combined with the settings of the STEP exporter.
+//  The exported files are stored in the cache directory under their key. When a model with the same key is requested
+//  again, its files are linked from the cache into the output directory and the construction of the geometry and the
+//  STEP translation can be skipped altogether.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef EXPORT_CACHE_H
+#define EXPORT_CACHE_H
+
+
+// Include standard C++ libraries
+#include <string>
+#include <vector>
+
+
+// Include the shared demo library
+#include "model_hash.h"
+#include "step_exporter.h"
+
+
+// Directory of the cache: the environment variable DEMO_EXPORT_CACHE or ../cache/ by default
+std::string default_export_cache_path();
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Cache of the files written by a StepExporter
+// ------------------------------------------------------------------------------------------------------------------ //
+class ExportCache {
+
+public:
+
+    // The settings of the exporter are part of the keys (and decide which files are cached)
+    explicit ExportCache(const StepExporter &step_exporter = default_step_exporter(),
+                         const std::string &cache_path = default_export_cache_path());
+
+    // Key of a model given the hash of its inputs
+    std::string key(const ModelHasher &model_inputs) const;
+
+    // Make the files <relative_path><model_name>.step (and .bbrep) available from the cache
+    // Returns false on a cache miss, in which case the model has to be built and exported, and then stored
+    bool fetch(const std::string &key, const std::string &relative_path, const std::string &model_name);
+
+    // Add the files <relative_path><model_name>.step (and .bbrep) to the cache
+    bool store(const std::string &key, const std::string &relative_path, const std::string &model_name);
+
+    // Number of cache hits and misses so far
+    int number_of_hits() const { return number_of_hits_; }
+    int number_of_misses() const { return number_of_misses_; }
+
+private:
+
+    std::string cache_path_;
+    std::string settings_digest_;
+    std::vector<std::string> extensions_;
+    int number_of_hits_ = 0;
+    int number_of_misses_ = 0;
+
+};
+
+
+#endif //EXPORT_CACHE_H
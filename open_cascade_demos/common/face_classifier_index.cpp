@@ -0,0 +1,277 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Fast classification of points in the parametric space of a face with many inner wires
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+
+// Include OpenCascade libraries
+#include <Precision.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Wire.hxx>
+#include <TopExp_Explorer.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepTools.hxx>
+#include <BRepAdaptor_Curve2d.hxx>
+#include <BRepClass_FaceClassifier.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+
+
+// Include the header of this module
+#include "face_classifier_index.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Maximum number of wires in a leaf of the hierarchy
+static const size_t WIRES_PER_LEAF = 4;
+
+// Number of consecutive items processed by a thread at a time
+static const size_t ITEMS_PER_BLOCK = 1024;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Constructor (the index itself is built on the first query)
+// ------------------------------------------------------------------------------------------------------------------ //
+FaceClassifierIndex::FaceClassifierIndex(const TopoDS_Face &face, double relative_deflection)
+        : face_(face), relative_deflection_(relative_deflection), number_of_exact_queries_(0) {}
+
+
+void FaceClassifierIndex::build() const {
+    call_once(build_flag_, &FaceClassifierIndex::build_index, this);
+}
+
+
+size_t FaceClassifierIndex::number_of_wires() const { build(); return wires_.size(); }
+size_t FaceClassifierIndex::number_of_segments() const { build(); return segments_.size(); }
+double FaceClassifierIndex::build_seconds() const { build(); return build_seconds_; }
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Build the polygons of the wires and the bounding volume hierarchy
+// ------------------------------------------------------------------------------------------------------------------ //
+void FaceClassifierIndex::build_index() const {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // Deflection of the polygons and tolerance of the edges in the parametric space
+    double u_min, u_max, v_min, v_max;
+    BRepTools::UVBounds(face_, u_min, u_max, v_min, v_max);
+    double deflection = relative_deflection_ * hypot(u_max - u_min, v_max - v_min);
+    tolerance_ = Precision::Confusion();
+    vector<TopoDS_Wire> face_wires;
+    for (TopExp_Explorer explorer(face_, TopAbs_WIRE); explorer.More(); explorer.Next()) {
+        face_wires.push_back(TopoDS::Wire(explorer.Current()));
+    }
+    for (TopExp_Explorer explorer(face_, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+        tolerance_ = max(tolerance_, BRep_Tool::Tolerance(TopoDS::Edge(explorer.Current())));
+    }
+
+    // The sagitta of the polygons can slightly exceed the requested deflection, hence the factor two
+    band_ = 2.0 * deflection + tolerance_;
+
+    // Polygonize the wires in parallel (the curves on surface of planar faces are computed on the fly)
+    TopoDS_Wire outer_wire = BRepTools::OuterWire(face_);
+    vector<vector<Segment>> wire_segments(face_wires.size());
+    wires_.assign(face_wires.size(), Wire());
+    size_t number_of_blocks = (face_wires.size() + ITEMS_PER_BLOCK - 1) / ITEMS_PER_BLOCK;
+    parallel_for(number_of_blocks, 0, [&](size_t block) {
+        size_t end = min(face_wires.size(), (block + 1) * ITEMS_PER_BLOCK);
+        for (size_t i = block * ITEMS_PER_BLOCK; i < end; ++i) {
+            Wire &wire = wires_[i];
+            wire.box_min[0] = wire.box_min[1] = numeric_limits<double>::max();
+            wire.box_max[0] = wire.box_max[1] = -numeric_limits<double>::max();
+            wire.is_outer = face_wires[i].IsSame(outer_wire);
+            for (TopExp_Explorer explorer(face_wires[i], TopAbs_EDGE); explorer.More(); explorer.Next()) {
+                const TopoDS_Edge &edge = TopoDS::Edge(explorer.Current());
+                if (BRep_Tool::Degenerated(edge)) { continue; }
+                BRepAdaptor_Curve2d curve(edge, face_);
+                GCPnts_TangentialDeflection points(curve, 0.2, deflection);
+                gp_Pnt2d previous = curve.Value(points.Parameter(1));
+                for (int k = 1; k <= points.NbPoints(); ++k) {
+                    gp_Pnt2d point = curve.Value(points.Parameter(k));
+                    wire.box_min[0] = min(wire.box_min[0], point.X());
+                    wire.box_min[1] = min(wire.box_min[1], point.Y());
+                    wire.box_max[0] = max(wire.box_max[0], point.X());
+                    wire.box_max[1] = max(wire.box_max[1], point.Y());
+                    if (k > 1) { wire_segments[i].push_back({previous.X(), previous.Y(), point.X(), point.Y()}); }
+                    previous = point;
+                }
+            }
+            // Enlarge the box by the band, so that the points close to the wire also find it
+            for (int axis = 0; axis < 2; ++axis) {
+                wire.box_min[axis] -= band_;
+                wire.box_max[axis] += band_;
+            }
+        }
+    });
+
+    // Store the segments of all the wires in a single list
+    segments_.clear();
+    has_outer_wire_ = false;
+    for (size_t i = 0; i < wires_.size(); ++i) {
+        wires_[i].segment_begin = segments_.size();
+        segments_.insert(segments_.end(), wire_segments[i].begin(), wire_segments[i].end());
+        wires_[i].segment_end = segments_.size();
+        has_outer_wire_ = has_outer_wire_ || wires_[i].is_outer;
+    }
+
+    // Build the hierarchy of the bounding boxes of the wires
+    wire_order_.resize(wires_.size());
+    for (size_t i = 0; i < wire_order_.size(); ++i) { wire_order_[i] = i; }
+    nodes_.clear();
+    if (!wires_.empty()) {
+        nodes_.reserve(2 * (wires_.size() / WIRES_PER_LEAF + 1));
+        nodes_.resize(1);
+        build_node(0, 0, wires_.size());
+    }
+
+    build_seconds_ = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+}
+
+
+// Fill the node with the wires [begin, end) of wire_order_, splitting them at the median of the longest axis
+void FaceClassifierIndex::build_node(size_t node_index, size_t begin, size_t end) const {
+
+    Node node;
+    node.box_min[0] = node.box_min[1] = numeric_limits<double>::max();
+    node.box_max[0] = node.box_max[1] = -numeric_limits<double>::max();
+    for (size_t i = begin; i < end; ++i) {
+        const Wire &wire = wires_[wire_order_[i]];
+        for (int axis = 0; axis < 2; ++axis) {
+            node.box_min[axis] = min(node.box_min[axis], wire.box_min[axis]);
+            node.box_max[axis] = max(node.box_max[axis], wire.box_max[axis]);
+        }
+    }
+
+    // Leaf
+    if (end - begin <= WIRES_PER_LEAF) {
+        node.first = begin;
+        node.count = end - begin;
+        nodes_[node_index] = node;
+        return;
+    }
+
+    // Inner node: sort the wires about the median of the centres of their boxes
+    int axis = (node.box_max[0] - node.box_min[0] >= node.box_max[1] - node.box_min[1]) ? 0 : 1;
+    size_t middle = begin + (end - begin) / 2;
+    nth_element(wire_order_.begin() + begin, wire_order_.begin() + middle, wire_order_.begin() + end,
+                [this, axis](size_t a, size_t b) {
+                    return wires_[a].box_min[axis] + wires_[a].box_max[axis] <
+                           wires_[b].box_min[axis] + wires_[b].box_max[axis];
+                });
+    node.first = nodes_.size();
+    node.count = 0;
+    nodes_[node_index] = node;
+    nodes_.resize(nodes_.size() + 2);
+    build_node(node.first, begin, middle);
+    build_node(node.first + 1, middle, end);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Position of a point relative to the polygon of a wire
+// ------------------------------------------------------------------------------------------------------------------ //
+void FaceClassifierIndex::test_wire(const Wire &wire, double u, double v, bool &is_inside, double &distance) const {
+
+    // Count the crossings of the ray from the point in the +u direction (even-odd rule) and find the closest segment
+    is_inside = false;
+    double square_distance = numeric_limits<double>::max();
+    for (size_t k = wire.segment_begin; k < wire.segment_end; ++k) {
+        const Segment &segment = segments_[k];
+        if ((segment.v0 > v) != (segment.v1 > v)) {
+            double u_crossing = segment.u0 + (v - segment.v0) * (segment.u1 - segment.u0) / (segment.v1 - segment.v0);
+            if (u < u_crossing) { is_inside = !is_inside; }
+        }
+        double du = segment.u1 - segment.u0;
+        double dv = segment.v1 - segment.v0;
+        double length = du * du + dv * dv;
+        double t = length > 0.0 ? ((u - segment.u0) * du + (v - segment.v0) * dv) / length : 0.0;
+        t = min(1.0, max(0.0, t));
+        double eu = segment.u0 + t * du - u;
+        double ev = segment.v0 + t * dv - v;
+        square_distance = min(square_distance, eu * eu + ev * ev);
+    }
+    distance = sqrt(square_distance);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Classify a point
+// ------------------------------------------------------------------------------------------------------------------ //
+TopAbs_State FaceClassifierIndex::classify(const gp_Pnt2d &point) const {
+
+    build();
+    double u = point.X();
+    double v = point.Y();
+
+    // Visit the wires whose boxes contain the point (a face without an outer wire is unbounded)
+    bool is_inside_outer = !has_outer_wire_;
+    bool is_inside_hole = false;
+    bool is_near_boundary = false;
+    size_t stack[64];
+    size_t stack_size = 0;
+    if (!nodes_.empty()) { stack[stack_size++] = 0; }
+    while (stack_size > 0) {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (u < node.box_min[0] || u > node.box_max[0] || v < node.box_min[1] || v > node.box_max[1]) { continue; }
+        if (node.count == 0) {
+            stack[stack_size++] = node.first;
+            stack[stack_size++] = node.first + 1;
+            continue;
+        }
+        for (size_t i = node.first; i < node.first + node.count; ++i) {
+            const Wire &wire = wires_[wire_order_[i]];
+            if (u < wire.box_min[0] || u > wire.box_max[0] || v < wire.box_min[1] || v > wire.box_max[1]) {
+                continue;
+            }
+            bool is_inside;
+            double distance;
+            test_wire(wire, u, v, is_inside, distance);
+            if (distance <= band_) { is_near_boundary = true; }
+            if (wire.is_outer) { is_inside_outer = is_inside; }
+            else if (is_inside) { is_inside_hole = true; }
+        }
+    }
+
+    // The polygons cannot decide the points close to the boundary
+    if (is_near_boundary) {
+        number_of_exact_queries_++;
+        BRepClass_FaceClassifier classifier(face_, point, tolerance_);
+        return classifier.State();
+    }
+    return (is_inside_outer && !is_inside_hole) ? TopAbs_IN : TopAbs_OUT;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Classify many points in parallel
+// ------------------------------------------------------------------------------------------------------------------ //
+void FaceClassifierIndex::classify(const vector<gp_Pnt2d> &points, vector<TopAbs_State> &states,
+                                   int number_of_threads) const {
+
+    build();
+    states.resize(points.size());
+    size_t number_of_blocks = (points.size() + ITEMS_PER_BLOCK - 1) / ITEMS_PER_BLOCK;
+    parallel_for(number_of_blocks, number_of_threads, [&](size_t block) {
+        size_t end = min(points.size(), (block + 1) * ITEMS_PER_BLOCK);
+        for (size_t i = block * ITEMS_PER_BLOCK; i < end; ++i) { states[i] = classify(points[i]); }
+    });
+
+}
@@ -0,0 +1,112 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Fast classification of points in the parametric space of a face with many inner wires
+//
+//  BRepClass_FaceClassifier intersects a ray with every edge of the face, so each query costs time proportional to
+//  the number of holes. The index approximates each wire by a polygon in the parametric space of the face and stores
+//  the bounding boxes of the wires in a bounding volume hierarchy (BVH). A query only visits the wires whose boxes
+//  contain the point, which takes logarithmic time when the wires do not overlap, and classifies the point against
+//  their polygons. The point is inside the face if it is inside the outer wire and outside every inner wire.
+//
+//  The polygons differ from the exact wires by less than the polygon deflection, so the points that are closer than
+//  this distance (plus the edge tolerance) to a polygon are classified again with BRepClass_FaceClassifier. This
+//  keeps the results identical to the exact classifier, which is also the only one that can answer TopAbs_ON.
+//
+//  The index is built on the first query (thread-safe), so creating an index that is never used costs nothing.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef FACE_CLASSIFIER_INDEX_H
+#define FACE_CLASSIFIER_INDEX_H
+
+
+// Include standard C++ libraries
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt2d.hxx>
+#include <TopAbs_State.hxx>
+#include <TopoDS_Face.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Point classifier of a face
+// ------------------------------------------------------------------------------------------------------------------ //
+class FaceClassifierIndex {
+
+public:
+
+    // The polygon deflection is relative to the diagonal of the parametric bounding box of the face
+    explicit FaceClassifierIndex(const TopoDS_Face &face, double relative_deflection = 1e-4);
+
+    FaceClassifierIndex(const FaceClassifierIndex &) = delete;
+    FaceClassifierIndex &operator=(const FaceClassifierIndex &) = delete;
+
+    // Classify a point given by its parameters (u, v) on the surface of the face (TopAbs_IN, TopAbs_OUT or TopAbs_ON)
+    TopAbs_State classify(const gp_Pnt2d &point) const;
+
+    // Classify many points, split among threads (the states are resized to the number of points)
+    void classify(const std::vector<gp_Pnt2d> &points, std::vector<TopAbs_State> &states,
+                  int number_of_threads = 0) const;
+
+    // Build the index now instead of on the first query
+    void build() const;
+
+    // Statistics of the index (building it if needed)
+    std::size_t number_of_wires() const;
+    std::size_t number_of_segments() const;
+    double build_seconds() const;
+
+    // Number of queries that were passed to the exact classifier because the point was close to a wire
+    std::size_t number_of_exact_queries() const { return number_of_exact_queries_; }
+
+private:
+
+    // Polygon of a wire (the segments of the wire are stored in [segment_begin, segment_end) of the segment list)
+    struct Wire {
+        double box_min[2];
+        double box_max[2];
+        std::size_t segment_begin;
+        std::size_t segment_end;
+        bool is_outer;
+    };
+
+    struct Segment {
+        double u0, v0, u1, v1;
+    };
+
+    // Node of the bounding volume hierarchy (leaves hold the wires [first, first + count) of wire_order_)
+    struct Node {
+        double box_min[2];
+        double box_max[2];
+        std::size_t first;          // First wire (leaf) or index of the first child (inner node)
+        std::size_t count;          // Number of wires (leaf) or zero (inner node, the second child follows the first)
+    };
+
+    void build_index() const;
+    void build_node(std::size_t node_index, std::size_t begin, std::size_t end) const;
+    void test_wire(const Wire &wire, double u, double v, bool &is_inside, double &distance) const;
+
+    TopoDS_Face face_;
+    double relative_deflection_;
+
+    // Index, built once on the first query
+    mutable std::once_flag build_flag_;
+    mutable std::vector<Wire> wires_;
+    mutable std::vector<Segment> segments_;
+    mutable std::vector<std::size_t> wire_order_;
+    mutable std::vector<Node> nodes_;
+    mutable bool has_outer_wire_ = false;
+    mutable double band_ = 0.0;             // Distance below which the exact classifier is used
+    mutable double tolerance_ = 0.0;        // Tolerance passed to the exact classifier
+    mutable double build_seconds_ = 0.0;
+    mutable std::atomic<std::size_t> number_of_exact_queries_;
+
+};
+
+
+#endif //FACE_CLASSIFIER_INDEX_H
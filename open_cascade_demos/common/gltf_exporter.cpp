@@ -0,0 +1,321 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Export of the triangle meshes to binary glTF 2.0 (.glb) with shared-geometry instancing
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Standard_Version.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_TrsfForm.hxx>
+#include <gp_XYZ.hxx>
+#include <TopAbs_Orientation.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+
+
+// Include the header of this module
+#include "gltf_exporter.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Triangle mesh of one TShape, in its local coordinates
+// ------------------------------------------------------------------------------------------------------------------ //
+struct InstanceMesh {
+    vector<float> positions;        // Three coordinates per node
+    vector<float> normals;          // Three components per node
+    vector<uint32_t> indices;       // Three nodes per triangle, counter-clockwise seen from outside the material
+};
+
+
+// Merge the triangulations of all the faces of the shape (the shape must be placed at its local origin)
+static InstanceMesh build_instance_mesh(const TopoDS_Shape &prototype) {
+
+    InstanceMesh mesh;
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(prototype, TopAbs_FACE, faces);
+
+    for (int i = 1; i <= faces.Extent(); ++i) {
+
+        // The location of the face is relative to the prototype
+        const TopoDS_Face &face = TopoDS::Face(faces(i));
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) { continue; }
+        const gp_Trsf &transformation = location.Transformation();
+        bool is_reversed = face.Orientation() == TopAbs_REVERSED;
+
+        // Nodes (the nodes of each face are separate, so the normals are not smoothed across the edges)
+        uint32_t first_node = uint32_t(mesh.positions.size() / 3);
+        for (int n = 1; n <= triangulation->NbNodes(); ++n) {
+#if OCC_VERSION_HEX >= 0x070600
+            gp_Pnt point = triangulation->Node(n).Transformed(transformation);
+#else
+            gp_Pnt point = triangulation->Nodes().Value(n).Transformed(transformation);
+#endif
+            mesh.positions.push_back(float(point.X()));
+            mesh.positions.push_back(float(point.Y()));
+            mesh.positions.push_back(float(point.Z()));
+        }
+
+        // Triangles, and node normals accumulated from the normals of the triangles (weighted by their area)
+        mesh.normals.resize(mesh.positions.size(), 0.0f);
+        for (int k = 1; k <= triangulation->NbTriangles(); ++k) {
+            int nodes[3];
+#if OCC_VERSION_HEX >= 0x070600
+            triangulation->Triangle(k).Get(nodes[0], nodes[1], nodes[2]);
+#else
+            triangulation->Triangles().Value(k).Get(nodes[0], nodes[1], nodes[2]);
+#endif
+            if (is_reversed) { swap(nodes[1], nodes[2]); }
+            uint32_t index[3];
+            gp_XYZ points[3];
+            for (int j = 0; j < 3; ++j) {
+                index[j] = first_node + uint32_t(nodes[j] - 1);
+                points[j].SetCoord(mesh.positions[3 * index[j]], mesh.positions[3 * index[j] + 1],
+                                   mesh.positions[3 * index[j] + 2]);
+                mesh.indices.push_back(index[j]);
+            }
+            gp_XYZ normal = (points[1] - points[0]).Crossed(points[2] - points[0]);
+            for (int j = 0; j < 3; ++j) {
+                mesh.normals[3 * index[j]] += float(normal.X());
+                mesh.normals[3 * index[j] + 1] += float(normal.Y());
+                mesh.normals[3 * index[j] + 2] += float(normal.Z());
+            }
+        }
+
+    }
+
+    // Normalize the node normals (glTF requires unit normals)
+    for (size_t n = 0; n < mesh.normals.size(); n += 3) {
+        float *normal = &mesh.normals[n];
+        float length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length > 0.0f) { for (int j = 0; j < 3; ++j) { normal[j] /= length; } }
+        else { normal[2] = 1.0f; }
+    }
+    return mesh;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Instances of the model: the non-compound shapes found by walking the compounds (with their global location)
+// ------------------------------------------------------------------------------------------------------------------ //
+static void collect_instances(const TopoDS_Shape &shape, vector<TopoDS_Shape> &instances) {
+
+    if (shape.ShapeType() == TopAbs_COMPOUND || shape.ShapeType() == TopAbs_COMPSOLID) {
+        for (TopoDS_Iterator iterator(shape); iterator.More(); iterator.Next()) {
+            collect_instances(iterator.Value(), instances);
+        }
+        return;
+    }
+    instances.push_back(shape);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Binary buffer of the file and JSON description of its content
+// ------------------------------------------------------------------------------------------------------------------ //
+class GlbBuilder {
+
+public:
+
+    // The bounds are written with the precision of the floats, the matrices with the precision of the doubles
+    GlbBuilder() {
+        accessors_.precision(9);
+        nodes_.precision(17);
+    }
+
+    // Append an array to the binary buffer and describe it with a buffer view and an accessor
+    // Returns the index of the accessor
+    template <typename T>
+    int add_accessor(const vector<T> &values, int component_type, const char *type, int components, int target,
+                     bool with_bounds) {
+
+        // Align every buffer view to 4 bytes
+        while (binary_.size() % 4 != 0) { binary_ += '\0'; }
+        size_t offset = binary_.size();
+        binary_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+
+        buffer_views_ << (number_of_buffer_views_ > 0 ? "," : "") << "{\"buffer\":0,\"byteOffset\":" << offset
+                      << ",\"byteLength\":" << values.size() * sizeof(T) << ",\"target\":" << target << "}";
+
+        accessors_ << (number_of_accessors_ > 0 ? "," : "") << "{\"bufferView\":" << number_of_buffer_views_
+                   << ",\"componentType\":" << component_type << ",\"count\":" << values.size() / components
+                   << ",\"type\":\"" << type << "\"";
+
+        // The POSITION accessors must give the bounds of their values
+        if (with_bounds) {
+            float lower[3] = {FLT_MAX, FLT_MAX, FLT_MAX}, upper[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            for (size_t i = 0; i < values.size(); ++i) {
+                lower[i % 3] = min(lower[i % 3], float(values[i]));
+                upper[i % 3] = max(upper[i % 3], float(values[i]));
+            }
+            accessors_ << ",\"min\":[" << lower[0] << "," << lower[1] << "," << lower[2] << "]"
+                       << ",\"max\":[" << upper[0] << "," << upper[1] << "," << upper[2] << "]";
+        }
+        accessors_ << "}";
+
+        number_of_buffer_views_++;
+        return number_of_accessors_++;
+
+    }
+
+    // Add a mesh made of one primitive and return its index
+    int add_mesh(const InstanceMesh &mesh) {
+        int position = add_accessor(mesh.positions, 5126, "VEC3", 3, 34962, true);
+        int normal = add_accessor(mesh.normals, 5126, "VEC3", 3, 34962, false);
+        int indices = add_accessor(mesh.indices, 5125, "SCALAR", 1, 34963, false);
+        meshes_ << (number_of_meshes_ > 0 ? "," : "") << "{\"primitives\":[{\"attributes\":{\"POSITION\":" << position
+                << ",\"NORMAL\":" << normal << "},\"indices\":" << indices << ",\"material\":0}]}";
+        return number_of_meshes_++;
+    }
+
+    // Add a node referencing a mesh, placed with a transformation
+    void add_node(int mesh, const gp_Trsf &transformation) {
+        nodes_ << (number_of_nodes_ > 0 ? "," : "") << "{\"mesh\":" << mesh;
+        if (transformation.Form() != gp_Identity) {
+            // The matrix is written column by column (the last row of an affine transformation is 0 0 0 1)
+            nodes_ << ",\"matrix\":[";
+            for (int column = 1; column <= 4; ++column) {
+                for (int row = 1; row <= 3; ++row) { nodes_ << transformation.Value(row, column) << ","; }
+                nodes_ << (column == 4 ? "1" : "0") << (column == 4 ? "]" : ",");
+            }
+        }
+        nodes_ << "}";
+        number_of_nodes_++;
+    }
+
+    // Write the file: header, JSON chunk and binary chunk (each chunk is padded to 4 bytes)
+    bool write(const string &file_name, size_t &number_of_bytes) {
+
+        ostringstream json;
+        json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"OpenCascade demos\"}"
+             << ",\"scene\":0,\"scenes\":[{";
+
+        // The schema does not allow empty arrays: without any triangulated face the scene is empty and the nodes
+        // and meshes are left out, like the buffers below
+        if (number_of_nodes_ > 0) {
+            json << "\"nodes\":[";
+            for (int i = 0; i < number_of_nodes_; ++i) { json << (i > 0 ? "," : "") << i; }
+            json << "]";
+        }
+        json << "}]";
+        if (number_of_nodes_ > 0) { json << ",\"nodes\":[" << nodes_.str() << "]"; }
+        if (number_of_meshes_ > 0) { json << ",\"meshes\":[" << meshes_.str() << "]"; }
+        json << ",\"materials\":[{\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.67,0.75,0.86,1.0],"
+             << "\"metallicFactor\":0.0,\"roughnessFactor\":0.6},\"doubleSided\":true}]";
+        if (!binary_.empty()) {
+            json << ",\"buffers\":[{\"byteLength\":" << binary_.size() << "}]"
+                 << ",\"bufferViews\":[" << buffer_views_.str() << "],\"accessors\":[" << accessors_.str() << "]";
+        }
+        json << "}";
+
+        string json_chunk = json.str();
+        while (json_chunk.size() % 4 != 0) { json_chunk += ' '; }
+        while (binary_.size() % 4 != 0) { binary_ += '\0'; }
+        uint32_t length = uint32_t(12 + 8 + json_chunk.size() + (binary_.empty() ? 0 : 8 + binary_.size()));
+
+        // glTF is little-endian, like the hosts this code runs on
+        ofstream file(file_name, ios::binary);
+        uint32_t header[3] = {0x46546C67u, 2u, length};                           // "glTF", version, length
+        uint32_t json_header[2] = {uint32_t(json_chunk.size()), 0x4E4F534Au};   // Length, "JSON"
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(json_header), sizeof(json_header));
+        file.write(json_chunk.data(), json_chunk.size());
+        if (!binary_.empty()) {
+            uint32_t binary_header[2] = {uint32_t(binary_.size()), 0x004E4942u};  // Length, "BIN"
+            file.write(reinterpret_cast<const char *>(binary_header), sizeof(binary_header));
+            file.write(binary_.data(), binary_.size());
+        }
+        number_of_bytes = length;
+        return !file.fail();
+
+    }
+
+private:
+
+    string binary_;
+    ostringstream buffer_views_, accessors_, meshes_, nodes_;
+    int number_of_buffer_views_ = 0, number_of_accessors_ = 0, number_of_meshes_ = 0, number_of_nodes_ = 0;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write the triangulation of the faces to a binary glTF file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_glb_file(const string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats,
+                    GlbInstanceStats *instance_stats) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    GlbInstanceStats counts;
+    GlbBuilder builder;
+
+    vector<TopoDS_Shape> instances;
+    if (!model_object.IsNull()) { collect_instances(model_object, instances); }
+
+    // Write the mesh of each (TShape, orientation) once, the first time it is found, and one node per instance
+    // (a mesh index of -1 marks a TShape without triangles)
+    map<pair<const void *, int>, pair<int, size_t>> meshes;
+    for (const TopoDS_Shape &instance : instances) {
+
+        // Before OpenCascade 7.6 a mirror can be a location, and the mirrored faces are reversed to keep their material
+        // side (see located_transform.h). A glTF viewer already swaps the winding of the nodes whose matrix has a
+        // negative determinant and carries the normals through the matrix, so the mesh of such an instance is built
+        // with the orientation reversed back, which also lets it share the mesh of the unmirrored instances
+        TopoDS_Shape prototype = instance.Located(TopLoc_Location());
+        if (instance.Location().Transformation().IsNegative()) { prototype.Reverse(); }
+
+        pair<const void *, int> key(prototype.TShape().get(), int(prototype.Orientation()));
+        auto found = meshes.find(key);
+        if (found == meshes.end()) {
+            InstanceMesh mesh = build_instance_mesh(prototype);
+            int mesh_index = mesh.indices.empty() ? -1 : builder.add_mesh(mesh);
+            found = meshes.insert(make_pair(key, make_pair(mesh_index, mesh.indices.size() / 3))).first;
+            if (mesh_index >= 0) {
+                counts.number_of_meshes++;
+                counts.number_of_triangles += mesh.indices.size() / 3;
+            }
+        }
+
+        if (found->second.first < 0) { continue; }
+        builder.add_node(found->second.first, instance.Location().Transformation());
+        counts.number_of_instances++;
+        counts.number_of_drawn_triangles += found->second.second;
+
+    }
+
+    bool is_done = builder.write(file_name, stats.number_of_bytes);
+    stats.write_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (instance_stats != nullptr) { *instance_stats = counts; }
+    return is_done;
+
+}
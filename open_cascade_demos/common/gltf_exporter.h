@@ -0,0 +1,53 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Export of the triangle meshes to binary glTF 2.0 (.glb) with shared-geometry instancing
+//
+//  Shapes that are copies of each other placed with a TopLoc_Location (for instance a face rotated with
+//  BRepBuilderAPI_Transform, or the blades of a bladed disk built with TopoDS_Shape::Moved) share the same TShape and
+//  therefore the same triangulation. The exporter walks the compounds of the model and keys every instance on its
+//  (TShape, orientation): the mesh of each key is written once, in the local coordinates of the TShape, and every
+//  instance becomes a node of the scene that references the mesh and carries the location as its matrix.
+//
+//  Mirror images placed with a location (possible before OpenCascade 7.6, see located_transform.h) share the mesh of
+//  the other instances: the matrix of their node has a negative determinant, which glTF handles by swapping the
+//  winding of the triangles. From OpenCascade 7.6 on, mirrors cannot be locations, and copies made with new geometry
+//  do not share their TShape and are written as separate meshes. Only the faces are exported, so models without faces
+//  (for instance a single curve) give an empty scene. The coordinates are written in the units of the model.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef GLTF_EXPORTER_H
+#define GLTF_EXPORTER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Include the shared demo library
+#include "mesh_exporter.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the instancing
+// ------------------------------------------------------------------------------------------------------------------ //
+struct GlbInstanceStats {
+    int number_of_meshes = 0;                       // Number of distinct meshes written to the file
+    int number_of_instances = 0;                    // Number of nodes referencing the meshes
+    std::size_t number_of_triangles = 0;            // Number of triangles written (each mesh once)
+    std::size_t number_of_drawn_triangles = 0;      // Number of triangles of the scene (each instance once)
+};
+
+
+// Write the triangulation of the faces to a binary glTF file, sharing the meshes between the instances of a TShape
+// The shape must be meshed first (see mesh_shape)
+bool write_glb_file(const std::string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats,
+                    GlbInstanceStats *instance_stats = nullptr);
+
+
+#endif //GLTF_EXPORTER_H
@@ -0,0 +1,142 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Patterns of circular holes in a planar face
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cmath>
+#include <map>
+
+
+// Include OpenCascade libraries
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Wire.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+
+
+// Include the header of this module
+#include "hole_pattern.h"
+#include "hole_validator.h"
+#include "parallel_build.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Placement of the holes
+// ------------------------------------------------------------------------------------------------------------------ //
+gp_Trsf hole_transformation(const HoleDescriptor &hole) {
+
+    // Rotate the prototype about its centre and then move it to the centre of the hole
+    gp_Trsf rotation;
+    rotation.SetRotation(gp::OZ(), hole.angle);
+    gp_Trsf translation;
+    translation.SetTranslation(gp_Vec(hole.x, hole.y, 0.0));
+    return translation.Multiplied(rotation);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Prototype of the holes
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Wire make_hole_prototype(double radius) {
+
+    gp_Ax2 axes(gp_Pnt(0.0, 0.0, 0.0), gp_Dir(0.0, 0.0, 1.0), gp_Dir(1.0, 0.0, 0.0));
+    TopoDS_Wire wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, radius)));
+    return TopoDS::Wire(wire.Reversed());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Patterns
+// ------------------------------------------------------------------------------------------------------------------ //
+void HolePattern::add_circular_pattern(double hole_radius, double x_center, double y_center, double pattern_radius,
+                                       int number_of_holes, double start_angle) {
+
+    for (int i = 0; i < number_of_holes; ++i) {
+        HoleDescriptor hole;
+        hole.angle = start_angle + 2.0 * M_PI * i / number_of_holes;
+        hole.x = x_center + pattern_radius * cos(hole.angle);
+        hole.y = y_center + pattern_radius * sin(hole.angle);
+        hole.radius = hole_radius;
+        holes_.push_back(hole);
+    }
+
+}
+
+
+void HolePattern::add_linear_pattern(double hole_radius, double x_start, double y_start, double x_step, double y_step,
+                                     int number_of_holes) {
+
+    for (int i = 0; i < number_of_holes; ++i) {
+        HoleDescriptor hole;
+        hole.x = x_start + i * x_step;
+        hole.y = y_start + i * y_step;
+        hole.radius = hole_radius;
+        holes_.push_back(hole);
+    }
+
+}
+
+
+void HolePattern::add_grid_pattern(double hole_radius, double x_start, double y_start, double x_step, double y_step,
+                                   int number_of_holes_x, int number_of_holes_y) {
+
+    for (int j = 0; j < number_of_holes_y; ++j) {
+        add_linear_pattern(hole_radius, x_start, y_start + j * y_step, x_step, 0.0, number_of_holes_x);
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Add the holes to the face
+// ------------------------------------------------------------------------------------------------------------------ //
+HolePatternStats HolePattern::add_to_face(TopoDS_Face &face, int number_of_threads) const {
+
+    HolePatternStats stats;
+
+    // One prototype per radius, built the first time the radius is found
+    map<double, TopoDS_Wire> prototypes;
+    for (const HoleDescriptor &hole : holes_) {
+        if (prototypes.find(hole.radius) == prototypes.end()) {
+            prototypes.insert(make_pair(hole.radius, make_hole_prototype(hole.radius)));
+        }
+    }
+
+    // Located instances of the prototypes (the threads only read the prototypes, see parallel_build.h)
+    parallel_build_into(face, holes_.size(), number_of_threads, [&](size_t i) -> TopoDS_Shape {
+        const HoleDescriptor &hole = holes_[i];
+        return prototypes.find(hole.radius)->second.Moved(TopLoc_Location(hole_transformation(hole)));
+    });
+
+    stats.number_of_holes = holes_.size();
+    stats.number_of_prototypes = int(prototypes.size());
+    return stats;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Check that the holes do not intersect each other or the boundaries of the annulus
+// ------------------------------------------------------------------------------------------------------------------ //
+HoleValidationReport HolePattern::validate(const AnnularRegion &region, double minimum_clearance,
+                                           int number_of_threads) const {
+
+    return validate_holes(holes_, region, minimum_clearance, number_of_threads);
+
+}
@@ -0,0 +1,107 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Patterns of circular holes in a planar face
+//
+//  A hole is described by its centre and radius in the XY plane and by a rotation about its centre (which sets where
+//  the seam of the circle lies). Instead of building a new circle, edge and wire for every hole, the pattern builds one
+//  prototype wire per distinct radius, centred at the origin, and adds each hole to the face as a located instance of
+//  the prototype (TopoDS_Shape::Moved). All the holes of the same radius share the same TShape, so the memory and the
+//  time spent building the geometry grow with the number of distinct hole shapes and not with the number of holes.
+//
+//  The sharing is kept by the native BRep format (see brep_cache.h), which stores each TShape once and the locations
+//  in a separate table. STEP has no way to share the bounds of a face, so the STEP export writes every hole in full.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef HOLE_PATTERN_H
+#define HOLE_PATTERN_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Trsf.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Circular hole in the XY plane
+// ------------------------------------------------------------------------------------------------------------------ //
+struct HoleDescriptor {
+    double x = 0.0;                 // X coordinate of the centre
+    double y = 0.0;                 // Y coordinate of the centre
+    double radius = 0.0;            // Radius of the hole
+    double angle = 0.0;             // Rotation of the hole about its centre (radians)
+};
+
+
+// Transformation that places the prototype of a hole (centred at the origin) at the position of the hole
+gp_Trsf hole_transformation(const HoleDescriptor &hole);
+
+// Inner wire of a hole of the given radius centred at the origin (reversed, as required for the inner bounds)
+TopoDS_Wire make_hole_prototype(double radius);
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the construction of the holes
+// ------------------------------------------------------------------------------------------------------------------ //
+struct HolePatternStats {
+    std::size_t number_of_holes = 0;        // Number of inner wires added to the face
+    int number_of_prototypes = 0;           // Number of distinct wires built (one per hole radius)
+};
+
+
+// Defined in hole_validator.h
+struct AnnularRegion;
+struct HoleValidationReport;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Pattern of circular holes
+// ------------------------------------------------------------------------------------------------------------------ //
+class HolePattern {
+
+public:
+
+    // Add a single hole
+    void add_hole(const HoleDescriptor &hole) { holes_.push_back(hole); }
+
+    // Add holes equally spaced on a circle, the first one at start_angle (each hole is rotated by its polar angle)
+    void add_circular_pattern(double hole_radius, double x_center, double y_center, double pattern_radius,
+                              int number_of_holes, double start_angle = 0.0);
+
+    // Add holes equally spaced on a line, the first one at (x_start, y_start)
+    void add_linear_pattern(double hole_radius, double x_start, double y_start, double x_step, double y_step,
+                            int number_of_holes);
+
+    // Add holes on a rectangular grid aligned with the axes, the first one at (x_start, y_start)
+    void add_grid_pattern(double hole_radius, double x_start, double y_start, double x_step, double y_step,
+                          int number_of_holes_x, int number_of_holes_y);
+
+    // Reserve memory for a number of holes
+    void reserve(std::size_t number_of_holes) { holes_.reserve(number_of_holes); }
+
+    // Get the holes of the pattern
+    const std::vector<HoleDescriptor> &holes() const { return holes_; }
+    std::size_t size() const { return holes_.size(); }
+
+    // Add the holes to the face as inner wires (located instances of one prototype wire per radius)
+    // The located wires can be created by several threads, they are added to the face in the order of the holes
+    HolePatternStats add_to_face(TopoDS_Face &face, int number_of_threads = 1) const;
+
+    // Check that the holes do not intersect each other or the boundaries of the annulus (see hole_validator.h)
+    HoleValidationReport validate(const AnnularRegion &region, double minimum_clearance = 0.0,
+                                  int number_of_threads = 0) const;
+
+private:
+
+    std::vector<HoleDescriptor> holes_;
+
+};
+
+
+#endif //HOLE_PATTERN_H
@@ -0,0 +1,183 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Validation of the holes of a perforated disk
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+
+// Include the header of this module
+#include "hole_validator.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Uniform grid over the centres of the holes (the holes of each cell are stored contiguously)
+// ------------------------------------------------------------------------------------------------------------------ //
+class HoleGrid {
+
+public:
+
+    HoleGrid(const vector<HoleDescriptor> &holes, double cell_size) : cell_size_(cell_size) {
+
+        // Get the bounds of the centres of the valid holes
+        x_min_ = y_min_ = HUGE_VAL;
+        double x_max = -HUGE_VAL, y_max = -HUGE_VAL;
+        for (const HoleDescriptor &hole : holes) {
+            if (!(hole.radius > 0.0)) { continue; }
+            x_min_ = min(x_min_, hole.x); x_max = max(x_max, hole.x);
+            y_min_ = min(y_min_, hole.y); y_max = max(y_max, hole.y);
+        }
+        if (x_min_ > x_max) { x_min_ = x_max = y_min_ = y_max = 0.0; }
+
+        // Use larger cells if the grid would have many more cells than holes (for instance a few distant holes)
+        size_t max_cells = 4 * holes.size() + 16;
+        while (true) {
+            nx_ = size_t((x_max - x_min_) / cell_size_) + 1;
+            ny_ = size_t((y_max - y_min_) / cell_size_) + 1;
+            if (double(nx_) * double(ny_) <= double(max_cells)) { break; }
+            cell_size_ *= 2.0;
+        }
+
+        // Sort the holes by cell (counting sort)
+        cell_start_.assign(nx_ * ny_ + 1, 0);
+        for (const HoleDescriptor &hole : holes) {
+            if (hole.radius > 0.0) { cell_start_[cell_of(hole) + 1]++; }
+        }
+        for (size_t c = 0; c < nx_ * ny_; ++c) { cell_start_[c + 1] += cell_start_[c]; }
+        cell_holes_.resize(cell_start_.back());
+        vector<size_t> next(cell_start_.begin(), cell_start_.end() - 1);
+        for (size_t i = 0; i < holes.size(); ++i) {
+            if (holes[i].radius > 0.0) { cell_holes_[next[cell_of(holes[i])]++] = i; }
+        }
+
+    }
+
+    // Call visit(j) for every hole in the 3x3 block of cells around the hole
+    template <typename Visitor>
+    void for_each_neighbor(const HoleDescriptor &hole, const Visitor &visit) const {
+        size_t ix = column(hole.x), iy = row(hole.y);
+        for (size_t cy = (iy > 0 ? iy - 1 : 0); cy <= min(iy + 1, ny_ - 1); ++cy) {
+            for (size_t cx = (ix > 0 ? ix - 1 : 0); cx <= min(ix + 1, nx_ - 1); ++cx) {
+                size_t cell = cy * nx_ + cx;
+                for (size_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) { visit(cell_holes_[k]); }
+            }
+        }
+    }
+
+private:
+
+    size_t column(double x) const { return min(size_t((x - x_min_) / cell_size_), nx_ - 1); }
+    size_t row(double y) const { return min(size_t((y - y_min_) / cell_size_), ny_ - 1); }
+    size_t cell_of(const HoleDescriptor &hole) const { return row(hole.y) * nx_ + column(hole.x); }
+
+    double cell_size_;
+    double x_min_, y_min_;
+    size_t nx_ = 1, ny_ = 1;
+    vector<size_t> cell_start_;     // Index of the first hole of each cell in cell_holes_
+    vector<size_t> cell_holes_;     // Indices of the holes sorted by cell
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Check that the holes do not intersect each other or the boundaries of the annulus
+// ------------------------------------------------------------------------------------------------------------------ //
+HoleValidationReport validate_holes(const vector<HoleDescriptor> &holes, const AnnularRegion &region,
+                                    double minimum_clearance, int number_of_threads) {
+
+    HoleValidationReport report;
+    if (holes.empty()) { return report; }
+
+    // Two holes can only be too close if the distance between their centres is below this cell size
+    double max_radius = 0.0;
+    for (const HoleDescriptor &hole : holes) { max_radius = max(max_radius, hole.radius); }
+    double cell_size = 2.0 * max_radius + max(minimum_clearance, 0.0);
+    HoleGrid grid(holes, cell_size > 0.0 ? cell_size : 1.0);
+
+    // Check every hole (each worker collects its own diagnostics)
+    vector<vector<HoleDiagnostic>> worker_diagnostics(resolve_number_of_threads(number_of_threads));
+    parallel_for_workers(holes.size(), number_of_threads, [&](int worker, size_t i) {
+
+        vector<HoleDiagnostic> &diagnostics = worker_diagnostics[worker];
+        const HoleDescriptor &hole = holes[i];
+        if (!(hole.radius > 0.0)) {
+            diagnostics.push_back({i, HOLE_INVALID_RADIUS, i, 0.0});
+            return;
+        }
+
+        // Boundaries of the annulus
+        double distance = hypot(hole.x - region.x_center, hole.y - region.y_center);
+        double inner_gap = distance - hole.radius - region.inner_radius;
+        if (region.inner_radius > 0.0 && inner_gap < minimum_clearance) {
+            diagnostics.push_back({i, HOLE_CROSSES_INNER_BOUNDARY, i, inner_gap});
+        }
+        double outer_gap = region.outer_radius - distance - hole.radius;
+        if (region.outer_radius > 0.0 && outer_gap < minimum_clearance) {
+            diagnostics.push_back({i, HOLE_CROSSES_OUTER_BOUNDARY, i, outer_gap});
+        }
+
+        // Other holes (each pair is checked once, by the hole with the smallest index)
+        grid.for_each_neighbor(hole, [&](size_t j) {
+            if (j <= i) { return; }
+            double gap = hypot(holes[j].x - hole.x, holes[j].y - hole.y) - hole.radius - holes[j].radius;
+            if (gap < minimum_clearance) { diagnostics.push_back({i, HOLE_OVERLAP, j, gap}); }
+        });
+
+    });
+
+    // Merge the diagnostics in a deterministic order
+    for (const vector<HoleDiagnostic> &diagnostics : worker_diagnostics) {
+        report.diagnostics.insert(report.diagnostics.end(), diagnostics.begin(), diagnostics.end());
+    }
+    sort(report.diagnostics.begin(), report.diagnostics.end(), [](const HoleDiagnostic &a, const HoleDiagnostic &b) {
+        return make_tuple(a.hole_index, int(a.problem), a.other_hole_index) <
+               make_tuple(b.hole_index, int(b.problem), b.other_hole_index);
+    });
+
+    for (const HoleDiagnostic &diagnostic : report.diagnostics) {
+        if (diagnostic.problem == HOLE_OVERLAP) { report.number_of_overlaps++; }
+        else if (diagnostic.problem == HOLE_INVALID_RADIUS) { report.number_of_invalid_radii++; }
+        else { report.number_of_boundary_problems++; }
+    }
+    report.is_valid = report.diagnostics.empty();
+    return report;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Print a summary and the first diagnostics
+// ------------------------------------------------------------------------------------------------------------------ //
+void HoleValidationReport::print(ostream &out, size_t max_diagnostics) const {
+
+    out << "Hole validation: " << (is_valid ? "valid" : "invalid") << " (" << number_of_overlaps << " overlaps, "
+        << number_of_boundary_problems << " boundary problems, " << number_of_invalid_radii << " invalid radii)"
+        << endl;
+
+    for (size_t k = 0; k < diagnostics.size() && k < max_diagnostics; ++k) {
+        const HoleDiagnostic &diagnostic = diagnostics[k];
+        out << "    Hole " << diagnostic.hole_index;
+        if (diagnostic.problem == HOLE_INVALID_RADIUS) {
+            out << " has a radius that is not positive" << endl;
+            continue;
+        }
+        if (diagnostic.problem == HOLE_OVERLAP) { out << " is too close to hole " << diagnostic.other_hole_index; }
+        if (diagnostic.problem == HOLE_CROSSES_INNER_BOUNDARY) { out << " is too close to the inner boundary"; }
+        if (diagnostic.problem == HOLE_CROSSES_OUTER_BOUNDARY) { out << " is too close to the outer boundary"; }
+        out << " (clearance " << diagnostic.clearance << ")" << endl;
+    }
+    if (diagnostics.size() > max_diagnostics) {
+        out << "    ... and " << diagnostics.size() - max_diagnostics << " more" << endl;
+    }
+
+}
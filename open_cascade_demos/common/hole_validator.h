@@ -0,0 +1,79 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Validation of the holes of a perforated disk
+//
+//  Checking every pair of holes is O(n^2). The validator sorts the holes into a uniform grid whose cells are as large
+//  as the largest hole (plus the clearance), so two holes can only intersect if they are in the same or in adjacent
+//  cells. Each hole is then compared with the holes of the 3x3 block of cells around it, which makes the validation
+//  linear in the number of holes when the holes have similar sizes. The holes are also checked against the inner and
+//  outer circles of the annulus. The holes are split among threads, and the diagnostics are sorted at the end so
+//  that they do not depend on the number of threads.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef HOLE_VALIDATOR_H
+#define HOLE_VALIDATOR_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Annulus that must contain the holes (an inner radius of zero gives a disk, an outer radius of zero no outer bound)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct AnnularRegion {
+    double x_center = 0.0;          // X coordinate of the centre
+    double y_center = 0.0;          // Y coordinate of the centre
+    double inner_radius = 0.0;      // Radius of the inner boundary circle
+    double outer_radius = 0.0;      // Radius of the outer boundary circle
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Problem found in a hole
+// ------------------------------------------------------------------------------------------------------------------ //
+enum HoleProblem {
+    HOLE_INVALID_RADIUS,            // The radius is not positive
+    HOLE_OVERLAP,                   // The hole intersects (or is too close to) another hole
+    HOLE_CROSSES_INNER_BOUNDARY,    // The hole intersects (or is too close to) the inner circle
+    HOLE_CROSSES_OUTER_BOUNDARY     // The hole intersects (or is too close to) the outer circle
+};
+
+
+struct HoleDiagnostic {
+    std::size_t hole_index;         // Index of the hole in the pattern
+    HoleProblem problem;            // Problem found
+    std::size_t other_hole_index;   // Index of the other hole (only for overlaps, where it is larger than hole_index)
+    double clearance;               // Gap between the boundaries (negative if they intersect)
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Result of the validation
+// ------------------------------------------------------------------------------------------------------------------ //
+struct HoleValidationReport {
+    bool is_valid = true;                           // True if no problem was found
+    std::size_t number_of_overlaps = 0;             // Number of pairs of holes that are too close
+    std::size_t number_of_boundary_problems = 0;    // Number of holes that are too close to the boundaries
+    std::size_t number_of_invalid_radii = 0;        // Number of holes with a radius that is not positive
+    std::vector<HoleDiagnostic> diagnostics;        // Problems sorted by hole index
+
+    // Print a summary and the first diagnostics
+    void print(std::ostream &out, std::size_t max_diagnostics = 20) const;
+};
+
+
+// Check that the holes do not intersect each other or the boundaries of the annulus
+// The clearance is the minimum gap required between the boundaries
+HoleValidationReport validate_holes(const std::vector<HoleDescriptor> &holes, const AnnularRegion &region,
+                                    double minimum_clearance = 0.0, int number_of_threads = 0);
+
+
+#endif //HOLE_VALIDATOR_H
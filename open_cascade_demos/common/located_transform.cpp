@@ -0,0 +1,74 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Rigid transformations of shapes expressed as locations
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cmath>
+
+
+// Include OpenCascade libraries
+#include <Standard_Version.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopExp_Explorer.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+
+
+// Include the header of this module
+#include "located_transform.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Tolerance on the scale factor of a rigid transformation
+static const double SCALE_TOLERANCE = 1e-12;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Classification of the transformations
+// ------------------------------------------------------------------------------------------------------------------ //
+bool is_rigid_transformation(const gp_Trsf &transformation) {
+
+    return fabs(fabs(transformation.ScaleFactor()) - 1.0) <= SCALE_TOLERANCE;
+
+}
+
+
+bool is_location_transformation(const gp_Trsf &transformation) {
+
+#if OCC_VERSION_HEX >= 0x070600
+    return is_rigid_transformation(transformation) && !transformation.IsNegative();
+#else
+    return is_rigid_transformation(transformation);
+#endif
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Transform the shape
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Shape located_transform(const TopoDS_Shape &shape, const gp_Trsf &transformation, bool *is_shared) {
+
+    // Copy the geometry when the transformation cannot be a location
+    if (!is_location_transformation(transformation)) {
+        if (is_shared != nullptr) { *is_shared = false; }
+        BRepBuilderAPI_Transform copy(shape, transformation, Standard_True);
+        return copy.Shape();
+    }
+
+    // Move the shape (the result shares the TShape of the original)
+    if (is_shared != nullptr) { *is_shared = true; }
+    TopoDS_Shape moved = shape.Moved(TopLoc_Location(transformation));
+
+    // A mirror turns the faces inside out, reversing them gives back the normals that point out of the material
+    // (edges and vertices alone have no material side, so they are left as they are)
+    if (transformation.IsNegative() && TopExp_Explorer(shape, TopAbs_FACE).More()) { moved.Reverse(); }
+    return moved;
+
+}
@@ -0,0 +1,41 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Rigid transformations of shapes expressed as locations
+//
+//  BRepBuilderAPI_Transform copies the geometry of the shape whenever the transformation is not a pure displacement
+//  (or when it is asked to), so a model made of transformed copies of a patch stores the patch once per copy. A
+//  rotation or a translation can instead be applied by changing the location of the shape (TopoDS_Shape::Moved): the
+//  transformed shape shares its TShape, and therefore its geometry, with the original, so the memory taken by a
+//  symmetric model drops by the number of copies. The exporters apply the locations when they write the shapes.
+//
+//  A mirror reverses the orientation of space, so a mirrored face has the opposite normal to the one expected from
+//  its material side. Before OpenCascade 7.6 a mirror can be stored as a location, and the faces are then reversed to
+//  restore their orientation. OpenCascade 7.6 forbids locations with a negative determinant, so mirrors (and scaling
+//  transformations in all versions) fall back to a copy of the geometry with BRepBuilderAPI_Transform. Since the
+//  composition of two mirrors is a rotation, the mirrored copy only needs to be made once: the other mirror images
+//  are rotations of it (for instance, mirror(rotation(S)) = inverse_rotation(mirror(S)) for a rotation about an axis
+//  that lies in the mirror plane).
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef LOCATED_TRANSFORM_H
+#define LOCATED_TRANSFORM_H
+
+
+// Include OpenCascade libraries
+#include <gp_Trsf.hxx>
+#include <TopoDS_Shape.hxx>
+
+
+// True if the transformation preserves distances (a rotation, translation or mirror, without scaling)
+bool is_rigid_transformation(const gp_Trsf &transformation);
+
+// True if the transformation can be stored as the location of a shape in this version of OpenCascade
+bool is_location_transformation(const gp_Trsf &transformation);
+
+// Transform the shape by changing its location when possible (sharing the geometry) and by copying it otherwise
+// is_shared is set to true when the result shares the geometry of the shape
+TopoDS_Shape located_transform(const TopoDS_Shape &shape, const gp_Trsf &transformation, bool *is_shared = nullptr);
+
+
+#endif //LOCATED_TRANSFORM_H
@@ -0,0 +1,300 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Tessellation of the models and export of the triangle meshes to binary STL and OBJ
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <Standard_Version.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_XYZ.hxx>
+#include <TopAbs_Orientation.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangulation.hxx>
+
+
+// Include the header of this module
+#include "mesh_exporter.h"
+#include "gltf_exporter.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Output file with a fixed-size buffer (the records are written to the buffer and the buffer to the file)
+// ------------------------------------------------------------------------------------------------------------------ //
+class BufferedOutput {
+
+public:
+
+    explicit BufferedOutput(const string &file_name) : file_(fopen(file_name.c_str(), "wb")) {
+        buffer_.reserve(BUFFER_SIZE);
+    }
+
+    ~BufferedOutput() { close(); }
+
+    bool is_open() const { return file_ != nullptr; }
+
+    void write(const void *data, size_t size) {
+        if (buffer_.size() + size > BUFFER_SIZE) { flush(); }
+        const char *bytes = static_cast<const char *>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    // Write the content of the buffer and close the file (returns false if any write failed)
+    bool close() {
+        if (file_ == nullptr) { return !failed_; }
+        flush();
+        if (fclose(file_) != 0) { failed_ = true; }
+        file_ = nullptr;
+        return !failed_;
+    }
+
+    size_t bytes_written() const { return bytes_written_; }
+
+private:
+
+    void flush() {
+        if (buffer_.empty()) { return; }
+        if (fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) { failed_ = true; }
+        bytes_written_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    static const size_t BUFFER_SIZE = 1 << 16;
+    FILE *file_;
+    vector<char> buffer_;
+    size_t bytes_written_ = 0;
+    bool failed_ = false;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Access to the triangulations of the faces
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Get a node of a triangulation (the array accessors were deprecated in OpenCascade 7.6)
+static inline gp_Pnt triangulation_node(const Handle(Poly_Triangulation) &triangulation, int index) {
+
+#if OCC_VERSION_HEX >= 0x070600
+    return triangulation->Node(index);
+#else
+    return triangulation->Nodes().Value(index);
+#endif
+
+}
+
+
+// Get the nodes of a triangle, in the order that makes its normal point out of the material of the face
+static inline void triangle_nodes(const Handle(Poly_Triangulation) &triangulation, int index, bool is_reversed,
+                                  int &n1, int &n2, int &n3) {
+
+#if OCC_VERSION_HEX >= 0x070600
+    triangulation->Triangle(index).Get(n1, n2, n3);
+#else
+    triangulation->Triangles().Value(index).Get(n1, n2, n3);
+#endif
+    if (is_reversed) { swap(n2, n3); }
+
+}
+
+
+// Call visit(triangulation, transformation, is_reversed) for every face of the shape that has a triangulation
+template <typename Visitor>
+static void for_each_triangulation(const TopoDS_Shape &model_object, const Visitor &visit) {
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(model_object, TopAbs_FACE, faces);
+    for (int i = 1; i <= faces.Extent(); ++i) {
+        const TopoDS_Face &face = TopoDS::Face(faces(i));
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) { continue; }
+        visit(triangulation, location.Transformation(), face.Orientation() == TopAbs_REVERSED);
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Mesh the faces of the shape and count the triangles
+// ------------------------------------------------------------------------------------------------------------------ //
+MeshExportStats mesh_shape(const TopoDS_Shape &model_object, const MeshExportOptions &options) {
+
+    MeshExportStats stats;
+    if (model_object.IsNull()) { return stats; }
+
+    // Convert the relative deflection into a distance
+    double deflection = options.linear_deflection;
+    if (options.relative_deflection) {
+        Bnd_Box bounding_box;
+        BRepBndLib::Add(model_object, bounding_box);
+        if (!bounding_box.IsVoid()) { deflection *= sqrt(bounding_box.SquareExtent()); }
+    }
+
+    // Mesh the faces (in parallel mode each face is meshed by a different thread)
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    BRepMesh_IncrementalMesh mesher(model_object, deflection, Standard_False, options.angular_deflection,
+                                    options.parallel);
+    stats.mesh_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Count the triangles
+    for_each_triangulation(model_object, [&stats](const Handle(Poly_Triangulation) &triangulation, const gp_Trsf &,
+                                                  bool) {
+        stats.number_of_faces++;
+        stats.number_of_triangles += triangulation->NbTriangles();
+        stats.number_of_nodes += triangulation->NbNodes();
+    });
+    return stats;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write the triangulation of the faces to a binary STL file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_stl_file(const string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // The number of triangles is written before the triangles, so it is counted first
+    size_t number_of_triangles = 0;
+    for_each_triangulation(model_object, [&number_of_triangles](const Handle(Poly_Triangulation) &triangulation,
+                                                                const gp_Trsf &, bool) {
+        number_of_triangles += triangulation->NbTriangles();
+    });
+    if (number_of_triangles > UINT32_MAX) { return false; }
+
+    BufferedOutput output(file_name);
+    if (!output.is_open()) { return false; }
+
+    // Header (80 bytes that must not start with "solid") and number of triangles
+    // The binary STL format is little-endian, like the hosts this code runs on
+    char header[80] = {};
+    strncpy(header, "Binary STL exported by the OpenCascade demos", sizeof(header) - 1);
+    output.write(header, sizeof(header));
+    uint32_t count = uint32_t(number_of_triangles);
+    output.write(&count, sizeof(count));
+
+    // Write one 50-byte record per triangle: normal, three vertices and an unused attribute
+    for_each_triangulation(model_object, [&output](const Handle(Poly_Triangulation) &triangulation,
+                                                   const gp_Trsf &transformation, bool is_reversed) {
+        for (int k = 1; k <= triangulation->NbTriangles(); ++k) {
+            int nodes[3];
+            triangle_nodes(triangulation, k, is_reversed, nodes[0], nodes[1], nodes[2]);
+            gp_XYZ points[3];
+            for (int j = 0; j < 3; ++j) {
+                points[j] = triangulation_node(triangulation, nodes[j]).Transformed(transformation).XYZ();
+            }
+            gp_XYZ normal = (points[1] - points[0]).Crossed(points[2] - points[0]);
+            double length = normal.Modulus();
+            if (length > 0.0) { normal /= length; }
+
+            float record[12] = {float(normal.X()), float(normal.Y()), float(normal.Z())};
+            for (int j = 0; j < 3; ++j) {
+                record[3 + 3 * j] = float(points[j].X());
+                record[4 + 3 * j] = float(points[j].Y());
+                record[5 + 3 * j] = float(points[j].Z());
+            }
+            uint16_t attribute = 0;
+            output.write(record, sizeof(record));
+            output.write(&attribute, sizeof(attribute));
+        }
+    });
+
+    bool is_done = output.close();
+    stats.number_of_bytes = output.bytes_written();
+    stats.write_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return is_done;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write the triangulation of the faces to an OBJ file, one group per face
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_obj_file(const string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    BufferedOutput output(file_name);
+    if (!output.is_open()) { return false; }
+    const char comment[] = "# OBJ exported by the OpenCascade demos\n";
+    output.write(comment, sizeof(comment) - 1);
+
+    // The nodes of each face are written before its triangles (OBJ indices are global and start at one)
+    size_t node_offset = 0;
+    int face_index = 0;
+    for_each_triangulation(model_object, [&](const Handle(Poly_Triangulation) &triangulation,
+                                             const gp_Trsf &transformation, bool is_reversed) {
+        char line[128];
+        int length = snprintf(line, sizeof(line), "g face_%d\n", ++face_index);
+        output.write(line, size_t(length));
+
+        for (int i = 1; i <= triangulation->NbNodes(); ++i) {
+            gp_Pnt point = triangulation_node(triangulation, i).Transformed(transformation);
+            length = snprintf(line, sizeof(line), "v %.9g %.9g %.9g\n", point.X(), point.Y(), point.Z());
+            output.write(line, size_t(length));
+        }
+
+        for (int k = 1; k <= triangulation->NbTriangles(); ++k) {
+            int n1, n2, n3;
+            triangle_nodes(triangulation, k, is_reversed, n1, n2, n3);
+            length = snprintf(line, sizeof(line), "f %zu %zu %zu\n", node_offset + n1, node_offset + n2,
+                              node_offset + n3);
+            output.write(line, size_t(length));
+        }
+
+        node_offset += triangulation->NbNodes();
+    });
+
+    bool is_done = output.close();
+    stats.number_of_bytes = output.bytes_written();
+    stats.write_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return is_done;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Mesh the shape and write the mesh file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool export_mesh(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object,
+                 const string &format, const MeshExportOptions &options, MeshExportStats &stats) {
+
+    if (format != "stl" && format != "obj" && format != "glb") { return false; }
+
+    // Create the output directory if it does not exist
+    mkdir(relative_path.c_str(), 0777);     // 0777 is used to give the user permissions to read+write+execute
+
+    // Mesh the shape and write the file
+    stats = mesh_shape(model_object, options);
+    string file_name = relative_path + model_name + "." + format;
+    if (format == "stl") { return write_stl_file(file_name, model_object, stats); }
+    if (format == "glb") { return write_glb_file(file_name, model_object, stats); }
+    return write_obj_file(file_name, model_object, stats);
+
+}
@@ -0,0 +1,67 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Tessellation of the models and export of the triangle meshes to binary STL and OBJ
+//
+//  The shape is meshed with BRepMesh_IncrementalMesh in parallel mode, which meshes the faces concurrently. The mesh
+//  is stored in the faces of the shape, so the writers stream the triangles directly from the triangulation of each
+//  face to a fixed-size output buffer, without assembling a global mesh in memory first. A face that already has a
+//  triangulation at least as fine as the requested deflection is not meshed again (use BRepTools::Clean to discard
+//  the existing triangulations).
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef MESH_EXPORTER_H
+#define MESH_EXPORTER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Options of the tessellation
+// ------------------------------------------------------------------------------------------------------------------ //
+struct MeshExportOptions {
+    double linear_deflection = 0.001;       // Maximum distance between the mesh and the surfaces
+    bool relative_deflection = true;        // The linear deflection is relative to the bounding box diagonal
+    double angular_deflection = 0.5;        // Maximum angle between the normals of adjacent triangles (radians)
+    bool parallel = true;                   // Mesh the faces in parallel
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the tessellation and of the export
+// ------------------------------------------------------------------------------------------------------------------ //
+struct MeshExportStats {
+    int number_of_faces = 0;                // Number of faces with a triangulation
+    std::size_t number_of_triangles = 0;    // Number of triangles of all the faces
+    std::size_t number_of_nodes = 0;        // Number of nodes of all the faces (shared edges are counted per face)
+    std::size_t number_of_bytes = 0;        // Size of the output file
+    double mesh_seconds = 0.0;              // Wall-clock time spent meshing
+    double write_seconds = 0.0;             // Wall-clock time spent writing the file
+
+    // Meshing throughput
+    double triangles_per_second() const { return mesh_seconds > 0.0 ? number_of_triangles / mesh_seconds : 0.0; }
+};
+
+
+// Mesh the faces of the shape and count the triangles (the mesh is stored in the faces)
+MeshExportStats mesh_shape(const TopoDS_Shape &model_object, const MeshExportOptions &options = MeshExportOptions());
+
+// Write the triangulation of the faces to a binary STL file (the shape must be meshed first)
+bool write_stl_file(const std::string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats);
+
+// Write the triangulation of the faces to an OBJ file, one group per face (the shape must be meshed first)
+bool write_obj_file(const std::string &file_name, const TopoDS_Shape &model_object, MeshExportStats &stats);
+
+// Mesh the shape and write <relative_path><model_name>.<format> (format is stl, obj or glb, see gltf_exporter.h)
+bool export_mesh(const std::string &relative_path, const std::string &model_name, const TopoDS_Shape &model_object,
+                 const std::string &format, const MeshExportOptions &options, MeshExportStats &stats);
+
+
+#endif //MESH_EXPORTER_H
@@ -0,0 +1,123 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Hash of the inputs of a model
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cstdio>
+
+
+// Include the header of this module
+#include "model_hash.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Incremental hash of the inputs of a model
+// ------------------------------------------------------------------------------------------------------------------ //
+void ModelHasher::add_bytes(const void *data, size_t size) {
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash_ ^= bytes[i];
+        hash_ *= 1099511628211ULL;      // FNV-1a prime
+    }
+
+}
+
+
+ModelHasher &ModelHasher::add(double value) {
+
+    // Positive and negative zero describe the same geometry
+    if (value == 0.0) { value = 0.0; }
+    add_bytes(&value, sizeof(value));
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(int value) {
+
+    add_bytes(&value, sizeof(value));
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const string &value) {
+
+    add(int(value.size()));
+    add_bytes(value.data(), value.size());
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const gp_Pnt &point) {
+
+    return add(point.X()).add(point.Y()).add(point.Z());
+
+}
+
+
+ModelHasher &ModelHasher::add(const TColgp_Array1OfPnt &points) {
+
+    add(points.Lower()).add(points.Upper());
+    for (int i = points.Lower(); i <= points.Upper(); ++i) { add(points(i)); }
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const TColgp_Array2OfPnt &points) {
+
+    add(points.LowerRow()).add(points.UpperRow()).add(points.LowerCol()).add(points.UpperCol());
+    for (int i = points.LowerRow(); i <= points.UpperRow(); ++i) {
+        for (int j = points.LowerCol(); j <= points.UpperCol(); ++j) { add(points(i, j)); }
+    }
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const TColStd_Array1OfReal &values) {
+
+    add(values.Lower()).add(values.Upper());
+    for (int i = values.Lower(); i <= values.Upper(); ++i) { add(values(i)); }
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const TColStd_Array2OfReal &values) {
+
+    add(values.LowerRow()).add(values.UpperRow()).add(values.LowerCol()).add(values.UpperCol());
+    for (int i = values.LowerRow(); i <= values.UpperRow(); ++i) {
+        for (int j = values.LowerCol(); j <= values.UpperCol(); ++j) { add(values(i, j)); }
+    }
+    return *this;
+
+}
+
+
+ModelHasher &ModelHasher::add(const TColStd_Array1OfInteger &values) {
+
+    add(values.Lower()).add(values.Upper());
+    for (int i = values.Lower(); i <= values.Upper(); ++i) { add(values(i)); }
+    return *this;
+
+}
+
+
+string ModelHasher::hex_digest() const {
+
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long) hash_);
+    return string(buffer);
+
+}
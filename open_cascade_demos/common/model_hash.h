@@ -0,0 +1,65 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Hash of the inputs of a model (control points, weights, knots, degrees, options...)
+//
+//  The values are hashed with the 64-bit FNV-1a function over their binary representation, so two models get the
+//  same key only if all their inputs are bit-for-bit identical. The bounds of the arrays are part of the hash.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef MODEL_HASH_H
+#define MODEL_HASH_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <gp_Pnt.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Incremental hash of the inputs of a model
+// ------------------------------------------------------------------------------------------------------------------ //
+class ModelHasher {
+
+public:
+
+    // Add scalar values and strings
+    ModelHasher &add(double value);
+    ModelHasher &add(int value);
+    ModelHasher &add(const std::string &value);
+    ModelHasher &add(const gp_Pnt &point);
+
+    // Add arrays (including their bounds)
+    ModelHasher &add(const TColgp_Array1OfPnt &points);
+    ModelHasher &add(const TColgp_Array2OfPnt &points);
+    ModelHasher &add(const TColStd_Array1OfReal &values);
+    ModelHasher &add(const TColStd_Array2OfReal &values);
+    ModelHasher &add(const TColStd_Array1OfInteger &values);
+
+    // Current value of the hash
+    std::uint64_t digest() const { return hash_; }
+
+    // Current value of the hash as 16 hexadecimal digits
+    std::string hex_digest() const;
+
+private:
+
+    // Mix raw bytes into the hash
+    void add_bytes(const void *data, std::size_t size);
+
+    std::uint64_t hash_ = 14695981039346656037ULL;      // FNV-1a offset basis
+
+};
+
+
+#endif //MODEL_HASH_H
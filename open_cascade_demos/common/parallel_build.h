@@ -0,0 +1,96 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Parallel construction of independent sub-shapes and deterministic assembly into a parent shape
+//
+//  BRep_Builder::Add modifies the parent shape, so it cannot be called by several threads at the same time. The
+//  sub-shapes themselves (hole wires, transformed patches, ...) are often independent, though, and building them is
+//  what takes the time. The helpers below split the construction in two steps:
+//
+//      1. The workers build the sub-shapes. The slots of the result are split into blocks of consecutive indices and
+//         each block is built by a single worker, so the workers never write to the same memory and no lock is taken
+//         (the blocks are handed out through the atomic counter of parallel_for.h).
+//      2. The calling thread adds the sub-shapes to the parent in the order of their indices.
+//
+//  The parent therefore has the same sub-shapes in the same order whatever the number of threads. The function that
+//  builds a sub-shape must only read shared data (for instance, a prototype shape that is moved to a new location).
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef PARALLEL_BUILD_H
+#define PARALLEL_BUILD_H
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Shape.hxx>
+#include <BRep_Builder.hxx>
+
+
+// Include the shared demo library
+#include "parallel_for.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Build shapes[i] = make_shape(i) for every i in [0, count) in parallel
+// ------------------------------------------------------------------------------------------------------------------ //
+template <typename MakeShape>
+std::vector<TopoDS_Shape> parallel_build_shapes(std::size_t count, int number_of_threads, const MakeShape &make_shape) {
+
+    // Blocks of up to 256 shapes, small enough to give every thread a few blocks when there are few shapes
+    number_of_threads = resolve_number_of_threads(number_of_threads);
+    std::size_t block_size = std::max(std::size_t(1), std::min(std::size_t(256), count / (4 * number_of_threads)));
+
+    std::vector<TopoDS_Shape> shapes(count);
+    std::size_t number_of_blocks = (count + block_size - 1) / block_size;
+    parallel_for(number_of_blocks, number_of_threads, [&](std::size_t block) {
+        std::size_t end = std::min(count, (block + 1) * block_size);
+        for (std::size_t i = block * block_size; i < end; ++i) { shapes[i] = make_shape(i); }
+    });
+    return shapes;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Add the shapes to the parent in the order of the vector (the null shapes are skipped)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline void add_shapes(TopoDS_Shape &parent, const std::vector<TopoDS_Shape> &shapes) {
+
+    BRep_Builder builder;
+    for (const TopoDS_Shape &shape : shapes) {
+        if (!shape.IsNull()) { builder.Add(parent, shape); }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Build the sub-shapes make_shape(i) in parallel and add them to the parent (or to a new compound) in index order
+// ------------------------------------------------------------------------------------------------------------------ //
+template <typename MakeShape>
+void parallel_build_into(TopoDS_Shape &parent, std::size_t count, int number_of_threads, const MakeShape &make_shape) {
+
+    add_shapes(parent, parallel_build_shapes(count, number_of_threads, make_shape));
+
+}
+
+
+template <typename MakeShape>
+TopoDS_Compound parallel_build_compound(std::size_t count, int number_of_threads, const MakeShape &make_shape) {
+
+    BRep_Builder builder;
+    TopoDS_Compound compound;
+    builder.MakeCompound(compound);
+    parallel_build_into(compound, count, number_of_threads, make_shape);
+    return compound;
+
+}
+
+
+#endif //PARALLEL_BUILD_H
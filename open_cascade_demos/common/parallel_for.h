@@ -0,0 +1,92 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Minimal thread pool helpers used by the parallel utilities of the shared demo library
+//
+//  The work items are handed out one at a time through an atomic counter, so that threads that get cheap items keep
+//  picking new ones instead of waiting for the slowest thread. Each work item must write its result to its own slot
+//  (for instance, the i-th entry of a preallocated vector), so that the results do not depend on the thread count.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+
+// Include standard C++ libraries
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Get the number of threads to use (zero or a negative number means one thread per hardware core)
+// ------------------------------------------------------------------------------------------------------------------ //
+inline int resolve_number_of_threads(int number_of_threads) {
+
+    if (number_of_threads > 0) { return number_of_threads; }
+    unsigned int hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads > 0 ? int(hardware_threads) : 1;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Call body(worker_index, i) for every i in [0, count) using a pool of worker threads
+// ------------------------------------------------------------------------------------------------------------------ //
+template <typename Body>
+void parallel_for_workers(std::size_t count, int number_of_threads, const Body &body) {
+
+    // Do not create more threads than work items
+    std::size_t number_of_workers = std::size_t(resolve_number_of_threads(number_of_threads));
+    if (number_of_workers > count) { number_of_workers = count; }
+
+    // Run on the calling thread when there is nothing to parallelize
+    if (number_of_workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) { body(0, i); }
+        return;
+    }
+
+    // Shared state of the pool: the next work item and the first exception thrown by a worker
+    std::atomic<std::size_t> next_item(0);
+    std::exception_ptr first_exception;
+    std::mutex exception_mutex;
+
+    // Each worker keeps picking work items until there are none left (or another worker failed)
+    auto worker = [&](int worker_index) {
+        try {
+            for (std::size_t i = next_item++; i < count; i = next_item++) { body(worker_index, i); }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if (!first_exception) { first_exception = std::current_exception(); }
+            next_item = count;
+        }
+    };
+
+    // Launch the workers and wait until all of them are done
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_workers);
+    for (std::size_t k = 0; k < number_of_workers; ++k) { threads.emplace_back(worker, int(k)); }
+    for (std::thread &thread : threads) { thread.join(); }
+
+    // Propagate the failure of a worker to the calling thread
+    if (first_exception) { std::rethrow_exception(first_exception); }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Call body(i) for every i in [0, count) using a pool of worker threads
+// ------------------------------------------------------------------------------------------------------------------ //
+template <typename Body>
+void parallel_for(std::size_t count, int number_of_threads, const Body &body) {
+
+    parallel_for_workers(count, number_of_threads, [&body](int, std::size_t i) { body(i); });
+
+}
+
+
+#endif //PARALLEL_FOR_H
@@ -0,0 +1,210 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Parametric model of the perforated disk of demo_perforated_disk with incremental re-evaluation
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <cmath>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
+#include <gp_Pnt.hxx>
+#include <Precision.hxx>
+#include <TopoDS.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+
+
+// Include the header of this module
+#include "perforated_disk_model.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Constructor
+// ------------------------------------------------------------------------------------------------------------------ //
+PerforatedDiskModel::PerforatedDiskModel(const PerforatedDiskParameters &parameters)
+        : parameters_(parameters), plane_(new Geom_Plane(gp_Pln())) {}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Change the parameters, invalidating the intermediate results that depend on them
+// ------------------------------------------------------------------------------------------------------------------ //
+void PerforatedDiskModel::set_parameters(const PerforatedDiskParameters &parameters) {
+
+    if (parameters.inner_radius != parameters_.inner_radius || parameters.outer_radius != parameters_.outer_radius) {
+        is_boundary_valid_ = false;
+        is_face_valid_ = false;
+    }
+    if (parameters.ring_radius != parameters_.ring_radius || parameters.number_of_holes != parameters_.number_of_holes
+        || parameters.start_angle != parameters_.start_angle) {
+        are_locations_valid_ = false;
+        are_hole_wires_valid_ = false;
+        is_face_valid_ = false;
+    }
+    if (parameters.hole_radius != parameters_.hole_radius) {
+        are_hole_wires_valid_ = false;
+        is_face_valid_ = false;
+    }
+    parameters_ = parameters;
+
+}
+
+
+void PerforatedDiskModel::set_number_of_holes(int number_of_holes) {
+    PerforatedDiskParameters parameters = parameters_;
+    parameters.number_of_holes = number_of_holes;
+    set_parameters(parameters);
+}
+
+
+void PerforatedDiskModel::set_ring_radius(double ring_radius) {
+    PerforatedDiskParameters parameters = parameters_;
+    parameters.ring_radius = ring_radius;
+    set_parameters(parameters);
+}
+
+
+void PerforatedDiskModel::set_hole_radius(double hole_radius) {
+    PerforatedDiskParameters parameters = parameters_;
+    parameters.hole_radius = hole_radius;
+    set_parameters(parameters);
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Face of the current parameters
+// ------------------------------------------------------------------------------------------------------------------ //
+const TopoDS_Face &PerforatedDiskModel::face() {
+
+    if (is_face_valid_) { return face_; }
+
+    // Boundary wires of the annulus
+    if (!is_boundary_valid_) {
+        gp_Ax2 axes(gp_Pnt(), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+        outer_wire_ = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, parameters_.outer_radius)));
+        TopoDS_Wire inner_wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes,
+                                                                                         parameters_.inner_radius)));
+        inner_wire_ = TopoDS::Wire(inner_wire.Reversed());
+        is_boundary_valid_ = true;
+        stats_.number_of_boundary_builds++;
+    }
+
+    // Locations of the holes on the ring (independent of the hole radius)
+    if (!are_locations_valid_) {
+        vector<HoleDescriptor> hole_positions = holes();
+        locations_.resize(hole_positions.size());
+        for (size_t i = 0; i < hole_positions.size(); ++i) {
+            locations_[i] = TopLoc_Location(hole_transformation(hole_positions[i]));
+        }
+        are_locations_valid_ = true;
+        stats_.number_of_locations += locations_.size();
+    }
+
+    // Located instances of the prototype of the current radius (the prototypes are kept for later variants)
+    if (!are_hole_wires_valid_) {
+        auto prototype = prototypes_.find(parameters_.hole_radius);
+        if (prototype == prototypes_.end()) {
+            prototype = prototypes_.insert(make_pair(parameters_.hole_radius,
+                                                     make_hole_prototype(parameters_.hole_radius))).first;
+            stats_.number_of_prototype_builds++;
+        }
+        hole_wires_.resize(locations_.size());
+        for (size_t i = 0; i < locations_.size(); ++i) {
+            hole_wires_[i] = TopoDS::Wire(prototype->second.Moved(locations_[i]));
+        }
+        are_hole_wires_valid_ = true;
+        stats_.number_of_hole_wires += hole_wires_.size();
+    }
+
+    // New face on the shared plane (the faces returned before keep their wires)
+    BRep_Builder builder;
+    builder.MakeFace(face_, plane_, Precision::Confusion());
+    builder.Add(face_, outer_wire_);
+    builder.Add(face_, inner_wire_);
+    for (const TopoDS_Wire &wire : hole_wires_) { builder.Add(face_, wire); }
+    is_face_valid_ = true;
+    stats_.number_of_faces++;
+    return face_;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Holes of the current parameters
+// ------------------------------------------------------------------------------------------------------------------ //
+vector<HoleDescriptor> PerforatedDiskModel::holes() const {
+
+    HolePattern hole_pattern;
+    hole_pattern.add_circular_pattern(parameters_.hole_radius, 0.0, 0.0, parameters_.ring_radius,
+                                      parameters_.number_of_holes, parameters_.start_angle);
+    return hole_pattern.holes();
+
+}
+
+
+HoleValidationReport PerforatedDiskModel::validate(double minimum_clearance) const {
+
+    AnnularRegion annulus;
+    annulus.inner_radius = parameters_.inner_radius;
+    annulus.outer_radius = parameters_.outer_radius;
+    // A single thread, since starting threads would take longer than validating a few holes
+    return validate_holes(holes(), annulus, minimum_clearance, 1);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Sweep over many variants of the disk
+// ------------------------------------------------------------------------------------------------------------------ //
+static void add_stats(PerforatedDiskModelStats &total, const PerforatedDiskModelStats &stats) {
+
+    total.number_of_faces += stats.number_of_faces;
+    total.number_of_boundary_builds += stats.number_of_boundary_builds;
+    total.number_of_prototype_builds += stats.number_of_prototype_builds;
+    total.number_of_locations += stats.number_of_locations;
+    total.number_of_hole_wires += stats.number_of_hole_wires;
+
+}
+
+
+DiskSweepResult sweep_perforated_disk(const vector<PerforatedDiskParameters> &variants, bool incremental,
+                                      const DiskVariantCallback &callback) {
+
+    DiskSweepResult result;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    PerforatedDiskModel model;
+    for (const PerforatedDiskParameters &parameters : variants) {
+
+        // Without the incremental model every variant starts from scratch
+        if (incremental) { model.set_parameters(parameters); }
+        else {
+            add_stats(result.model_stats, model.stats());
+            model = PerforatedDiskModel(parameters);
+        }
+
+        const TopoDS_Face &face = model.face();
+        HoleValidationReport report = model.validate();
+        if (report.is_valid) { result.number_of_valid_variants++; }
+        if (callback) { callback(parameters, face, report); }
+        result.number_of_variants++;
+
+    }
+    add_stats(result.model_stats, model.stats());
+
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+
+}
@@ -0,0 +1,141 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Parametric model of the perforated disk of demo_perforated_disk with incremental re-evaluation
+//
+//  Design studies evaluate thousands of variants of the disk that differ in the number of holes, the radius of the
+//  ring of holes or the radius of the holes. Rebuilding the whole face for every variant repeats a lot of work, so the
+//  model keeps the intermediate results and rebuilds only the ones that depend on the parameters that changed:
+//
+//      boundary wires      <- inner and outer radius of the disk
+//      hole prototype      <- hole radius (one wire per radius, kept for the next variants with the same radius)
+//      hole locations      <- number of holes, ring radius and start angle
+//      hole wires          <- hole prototype and hole locations (located instances, see hole_pattern.h)
+//      face                <- boundary wires and hole wires
+//
+//  Changing the hole radius, for instance, builds a single circle and moves it to the locations of the previous
+//  variant, while the boundary wires and the plane are reused. The face is a new shape for every variant (copies of
+//  the faces returned before are not modified), but all the faces share the geometry of the wires.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef PERFORATED_DISK_MODEL_H
+#define PERFORATED_DISK_MODEL_H
+
+
+// Include standard C++ libraries
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Geom_Plane.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+#include "hole_validator.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Parameters of the disk (the default values give the disk of demo_perforated_disk)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct PerforatedDiskParameters {
+    double inner_radius = 1.0;              // Radius of the inner boundary of the disk
+    double outer_radius = 2.0;              // Radius of the outer boundary of the disk
+    double ring_radius = 1.5;               // Radius of the circle through the centres of the holes
+    double hole_radius = 0.1;               // Radius of the holes
+    int number_of_holes = 29;               // Number of holes, equally spaced on the ring
+    double start_angle = 2.0 * M_PI / 29;   // Polar angle of the first hole
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Work done by the model since it was created
+// ------------------------------------------------------------------------------------------------------------------ //
+struct PerforatedDiskModelStats {
+    std::size_t number_of_faces = 0;                // Number of faces built
+    std::size_t number_of_boundary_builds = 0;      // Number of times the boundary wires were built
+    std::size_t number_of_prototype_builds = 0;     // Number of hole prototypes built
+    std::size_t number_of_locations = 0;            // Number of hole locations computed
+    std::size_t number_of_hole_wires = 0;           // Number of located hole wires created
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Perforated disk with incremental re-evaluation
+// ------------------------------------------------------------------------------------------------------------------ //
+class PerforatedDiskModel {
+
+public:
+
+    explicit PerforatedDiskModel(const PerforatedDiskParameters &parameters = PerforatedDiskParameters());
+
+    // Change the parameters (the model is re-evaluated on the next call to face)
+    void set_parameters(const PerforatedDiskParameters &parameters);
+    void set_number_of_holes(int number_of_holes);
+    void set_ring_radius(double ring_radius);
+    void set_hole_radius(double hole_radius);
+    const PerforatedDiskParameters &parameters() const { return parameters_; }
+
+    // Face of the current parameters (rebuilding only the parts that depend on the parameters that changed)
+    const TopoDS_Face &face();
+
+    // Holes of the current parameters and their validation against the annulus (see hole_validator.h)
+    std::vector<HoleDescriptor> holes() const;
+    HoleValidationReport validate(double minimum_clearance = 0.0) const;
+
+    const PerforatedDiskModelStats &stats() const { return stats_; }
+
+private:
+
+    PerforatedDiskParameters parameters_;
+    PerforatedDiskModelStats stats_;
+
+    // Flags of the intermediate results that must be rebuilt
+    bool is_boundary_valid_ = false;
+    bool are_locations_valid_ = false;
+    bool are_hole_wires_valid_ = false;
+    bool is_face_valid_ = false;
+
+    // Intermediate results
+    Handle(Geom_Plane) plane_;
+    TopoDS_Wire outer_wire_;
+    TopoDS_Wire inner_wire_;
+    std::map<double, TopoDS_Wire> prototypes_;
+    std::vector<TopLoc_Location> locations_;
+    std::vector<TopoDS_Wire> hole_wires_;
+    TopoDS_Face face_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Sweep over many variants of the disk
+// ------------------------------------------------------------------------------------------------------------------ //
+struct DiskSweepResult {
+    std::size_t number_of_variants = 0;         // Number of variants evaluated
+    std::size_t number_of_valid_variants = 0;   // Number of variants whose holes passed the validation
+    double seconds = 0.0;                       // Wall-clock time of the sweep
+    PerforatedDiskModelStats model_stats;       // Work done by the model (summed over the models if not incremental)
+
+    double variants_per_second() const { return seconds > 0.0 ? number_of_variants / seconds : 0.0; }
+};
+
+
+// Function called with the parameters, the face and the validation report of every variant
+typedef std::function<void(const PerforatedDiskParameters &, const TopoDS_Face &, const HoleValidationReport &)>
+        DiskVariantCallback;
+
+// Build and validate every variant, in order, with one incremental model (or a new model per variant otherwise)
+// Ordering the variants so that consecutive ones differ in few parameters (the hole radius first) gives most reuse
+DiskSweepResult sweep_perforated_disk(const std::vector<PerforatedDiskParameters> &variants, bool incremental = true,
+                                      const DiskVariantCallback &callback = DiskVariantCallback());
+
+
+#endif //PERFORATED_DISK_MODEL_H
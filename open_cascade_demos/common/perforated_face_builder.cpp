@@ -0,0 +1,119 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Bulk construction of planar faces with a large number of circular holes
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax2.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_XYZ.hxx>
+#include <Precision.hxx>
+#include <Geom_Circle.hxx>
+#include <Geom_Plane.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <BRep_Builder.hxx>
+
+
+// Include the header of this module
+#include "perforated_face_builder.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Number of consecutive holes built by a thread at a time (large enough to make the scheduling cost negligible)
+static const size_t HOLES_PER_BLOCK = 4096;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Inner wire of a hole (one circle, one vertex, one edge and one wire built directly with BRep_Builder)
+// ------------------------------------------------------------------------------------------------------------------ //
+static TopoDS_Wire make_hole_wire(const BRep_Builder &builder, const gp_Pln &plane, const HoleDescriptor &hole) {
+
+    const double tolerance = Precision::Confusion();
+
+    // Circle centred at the hole with its seam at the rotation angle of the hole (as in hole_transformation)
+    const gp_Ax3 &position = plane.Position();
+    gp_XYZ x_direction = position.XDirection().XYZ();
+    gp_XYZ y_direction = position.YDirection().XYZ();
+    gp_Pnt center(position.Location().XYZ() + hole.x * x_direction + hole.y * y_direction);
+    gp_Dir seam_direction(cos(hole.angle) * x_direction + sin(hole.angle) * y_direction);
+    Handle(Geom_Circle) circle = new Geom_Circle(gp_Ax2(center, position.Direction(), seam_direction), hole.radius);
+
+    // Closed edge that starts and ends at the same vertex (the same representation as BRepBuilderAPI_MakeEdge gives)
+    TopoDS_Vertex vertex;
+    builder.MakeVertex(vertex, circle->Value(0.0), tolerance);
+    TopoDS_Edge edge;
+    builder.MakeEdge(edge, circle, tolerance);
+    TopoDS_Vertex last_vertex = TopoDS::Vertex(vertex.Reversed());
+    builder.Add(edge, vertex);
+    builder.Add(edge, last_vertex);
+    builder.UpdateVertex(vertex, 0.0, edge, tolerance);
+    builder.UpdateVertex(last_vertex, 2.0 * M_PI, edge, tolerance);
+    builder.Range(edge, 0.0, 2.0 * M_PI);
+    edge.Closed(Standard_True);
+
+    // Wire with the single edge, reversed as required for the inner bounds of a face
+    TopoDS_Wire wire;
+    builder.MakeWire(wire);
+    builder.Add(wire, edge);
+    wire.Closed(Standard_True);
+    return TopoDS::Wire(wire.Reversed());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Build the face of the plane with the outer wire and the holes
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Face make_perforated_face(const gp_Pln &plane, const TopoDS_Wire &outer_wire, const HoleDescriptor *holes,
+                                 size_t number_of_holes, int number_of_threads, PerforatedFaceStats *stats) {
+
+    BRep_Builder builder;
+    size_t number_of_blocks = (number_of_holes + HOLES_PER_BLOCK - 1) / HOLES_PER_BLOCK;
+    number_of_threads = resolve_number_of_threads(number_of_threads);
+    if (size_t(number_of_threads) > number_of_blocks) { number_of_threads = int(max(number_of_blocks, size_t(1))); }
+
+    // Build the wires of the holes in parallel (each thread builds independent shapes and writes its own slots)
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<TopoDS_Wire> wires(number_of_holes);
+    parallel_for(number_of_blocks, number_of_threads, [&](size_t block) {
+        size_t end = min(number_of_holes, (block + 1) * HOLES_PER_BLOCK);
+        for (size_t i = block * HOLES_PER_BLOCK; i < end; ++i) {
+            wires[i] = make_hole_wire(builder, plane, holes[i]);
+        }
+    });
+    double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Add the bounds to the face in the order of the hole array
+    // The planar surface does not need curves on surface, they are computed from the 3D curves when required
+    start = chrono::steady_clock::now();
+    TopoDS_Face face;
+    builder.MakeFace(face, new Geom_Plane(plane), Precision::Confusion());
+    if (!outer_wire.IsNull()) { builder.Add(face, outer_wire); }
+    for (const TopoDS_Wire &wire : wires) { builder.Add(face, wire); }
+    double assembly_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (stats != nullptr) {
+        stats->number_of_holes = number_of_holes;
+        stats->number_of_threads = number_of_threads;
+        stats->build_seconds = build_seconds;
+        stats->assembly_seconds = assembly_seconds;
+    }
+    return face;
+
+}
@@ -0,0 +1,53 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Bulk construction of planar faces with a large number of circular holes
+//
+//  Building a hole with BRepBuilderAPI_MakeEdge and BRepBuilderAPI_MakeWire creates several temporary algorithm
+//  objects per hole (with their own maps and lists) just to produce one circle, one vertex, one edge and one wire. The
+//  bulk builder creates these shapes directly with BRep_Builder, so each hole costs a fixed number of allocations, and
+//  builds the holes of consecutive blocks of the hole array in parallel. The wires are stored in a vector sized once
+//  for all the holes and are then added to the face in the order of the array, so the face does not depend on the
+//  number of threads.
+//
+//  Every hole gets its own edge and circle. Use HolePattern::add_to_face (see hole_pattern.h) when the holes may share
+//  the geometry of a prototype instead.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef PERFORATED_FACE_BUILDER_H
+#define PERFORATED_FACE_BUILDER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+
+
+// Include OpenCascade libraries
+#include <gp_Pln.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the construction of the face
+// ------------------------------------------------------------------------------------------------------------------ //
+struct PerforatedFaceStats {
+    std::size_t number_of_holes = 0;        // Number of inner wires added to the face
+    int number_of_threads = 0;              // Number of threads used to build the holes
+    double build_seconds = 0.0;             // Wall-clock time spent building the edges and wires of the holes
+    double assembly_seconds = 0.0;          // Wall-clock time spent adding the wires to the face
+};
+
+
+// Build the face of the plane bounded by the outer wire with the holes given by a contiguous array of descriptors
+// The centres of the holes are given in the local coordinates of the plane (a null outer wire gives an unbounded face)
+TopoDS_Face make_perforated_face(const gp_Pln &plane, const TopoDS_Wire &outer_wire, const HoleDescriptor *holes,
+                                 std::size_t number_of_holes, int number_of_threads = 0,
+                                 PerforatedFaceStats *stats = nullptr);
+
+
+#endif //PERFORATED_FACE_BUILDER_H
@@ -0,0 +1,260 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Minimal PNG writer for RGB images
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cstdint>
+#include <fstream>
+
+
+// Include the header of this module
+#include "png_writer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Checksums of the PNG chunks (CRC-32) and of the zlib stream (Adler-32)
+// ------------------------------------------------------------------------------------------------------------------ //
+static uint32_t crc32(const string &data, size_t begin) {
+
+    // The table is computed once (the initialization of local statics is thread-safe)
+    static const vector<uint32_t> table = [] {
+        vector<uint32_t> values(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) { c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1; }
+            values[n] = c;
+        }
+        return values;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = begin; i < data.size(); ++i) { crc = table[(crc ^ (unsigned char) data[i]) & 0xFF] ^ (crc >> 8); }
+    return crc ^ 0xFFFFFFFFu;
+
+}
+
+
+static uint32_t adler32(const string &data) {
+
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        a = (a + (unsigned char) data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+
+}
+
+
+// Append a 32-bit integer in big-endian order
+static void append_uint32(string &output, uint32_t value) {
+
+    output += char((value >> 24) & 0xFF);
+    output += char((value >> 16) & 0xFF);
+    output += char((value >> 8) & 0xFF);
+    output += char(value & 0xFF);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Deflate encoder with the fixed Huffman codes
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Writer of a stream of bits, starting from the least significant bit of each byte
+class BitWriter {
+
+public:
+
+    explicit BitWriter(string &output) : output_(output) {}
+
+    // Write the lowest bits of a value (extra bits and block headers)
+    void write(uint32_t bits, int count) {
+        buffer_ |= uint64_t(bits) << filled_;
+        filled_ += count;
+        while (filled_ >= 8) {
+            output_ += char(buffer_ & 0xFF);
+            buffer_ >>= 8;
+            filled_ -= 8;
+        }
+    }
+
+    // Write a Huffman code (the codes are packed starting from their most significant bit)
+    void write_code(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int k = 0; k < length; ++k) { reversed = (reversed << 1) | ((code >> k) & 1); }
+        write(reversed, length);
+    }
+
+    // Write the incomplete last byte
+    void flush() {
+        if (filled_ > 0) { output_ += char(buffer_ & 0xFF); }
+        buffer_ = 0;
+        filled_ = 0;
+    }
+
+private:
+
+    string &output_;
+    uint64_t buffer_ = 0;
+    int filled_ = 0;
+
+};
+
+
+// Base values and number of extra bits of the length codes (257 to 285) and of the distance codes (0 to 29)
+static const int LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99,
+                                    115, 131, 163, 195, 227, 258};
+static const int LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5,
+                                     0};
+static const int DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                                      1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const int DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+                                       12, 12, 13, 13};
+
+
+// Write a symbol of the literal/length alphabet with its fixed Huffman code
+static void write_symbol(BitWriter &writer, int symbol) {
+
+    if (symbol < 144) { writer.write_code(0x30 + symbol, 8); }
+    else if (symbol < 256) { writer.write_code(0x190 + symbol - 144, 9); }
+    else if (symbol < 280) { writer.write_code(symbol - 256, 7); }
+    else { writer.write_code(0xC0 + symbol - 280, 8); }
+
+}
+
+
+// Write a match of <length> bytes found <distance> bytes back
+static void write_match(BitWriter &writer, int length, int distance) {
+
+    int code = 28;
+    while (LENGTH_BASE[code] > length) { code--; }
+    write_symbol(writer, 257 + code);
+    writer.write(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+    code = 29;
+    while (DISTANCE_BASE[code] > distance) { code--; }
+    writer.write_code(code, 5);
+    writer.write(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+
+}
+
+
+// Compress the data as a single deflate block, looking for repetitions at the given distances only
+static void deflate_fixed(const string &data, const vector<int> &distances, string &output) {
+
+    BitWriter writer(output);
+    writer.write(1, 1);     // Last block
+    writer.write(1, 2);     // Compressed with the fixed Huffman codes
+
+    size_t i = 0;
+    while (i < data.size()) {
+
+        // Find the longest repetition among the candidate distances
+        int best_length = 0, best_distance = 0;
+        for (int distance : distances) {
+            if (i < size_t(distance)) { continue; }
+            int length = 0;
+            while (length < 258 && i + length < data.size() && data[i + length] == data[i + length - distance]) {
+                length++;
+            }
+            if (length > best_length) {
+                best_length = length;
+                best_distance = distance;
+            }
+        }
+
+        // Write a match or a literal byte
+        if (best_length >= 3) {
+            write_match(writer, best_length, best_distance);
+            i += best_length;
+        }
+        else {
+            write_symbol(writer, (unsigned char) data[i]);
+            i++;
+        }
+
+    }
+
+    write_symbol(writer, 256);  // End of block
+    writer.flush();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Encode the image as the content of a PNG file
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Append a chunk (length, type, data and CRC of the type and data)
+static void append_chunk(string &png, const char *type, const string &data) {
+
+    append_uint32(png, uint32_t(data.size()));
+    size_t begin = png.size();
+    png += type;
+    png += data;
+    append_uint32(png, crc32(png, begin));
+
+}
+
+
+string encode_png(const RgbImage &image) {
+
+    // Header: size, 8 bits per channel, RGB, default compression, filter and no interlacing
+    string header;
+    append_uint32(header, uint32_t(image.width));
+    append_uint32(header, uint32_t(image.height));
+    header += char(8);
+    header += char(2);
+    header += char(0);
+    header += char(0);
+    header += char(0);
+
+    // Scanlines, each one preceded by its filter type (0 = no filter)
+    size_t row_size = 3 * size_t(image.width);
+    string scanlines;
+    scanlines.reserve((row_size + 1) * image.height);
+    for (int y = 0; y < image.height; ++y) {
+        scanlines += char(0);
+        scanlines.append(reinterpret_cast<const char *>(image.pixel(0, y)), row_size);
+    }
+
+    // Compressed data: zlib header, deflate stream and Adler-32 checksum
+    // The candidate repetitions are the previous pixel and the pixel above (when it is within the deflate window)
+    vector<int> distances = {3};
+    if (row_size + 1 <= 32768) { distances.push_back(int(row_size + 1)); }
+    string compressed;
+    compressed += char(0x78);
+    compressed += char(0x01);
+    deflate_fixed(scanlines, distances, compressed);
+    append_uint32(compressed, adler32(scanlines));
+
+    // Signature and chunks
+    string png = "\x89PNG\r\n\x1a\n";
+    append_chunk(png, "IHDR", header);
+    append_chunk(png, "IDAT", compressed);
+    append_chunk(png, "IEND", string());
+    return png;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write the image to a PNG file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_png_file(const string &file_name, const RgbImage &image) {
+
+    if (image.width <= 0 || image.height <= 0) { return false; }
+    string png = encode_png(image);
+    ofstream file(file_name, ios::binary);
+    file.write(png.data(), png.size());
+    return !file.fail();
+
+}
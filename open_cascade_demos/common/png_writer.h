@@ -0,0 +1,51 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Minimal PNG writer for RGB images
+//
+//  The image is encoded as an 8-bit RGB PNG without any external library. The scanlines are compressed with a small
+//  deflate encoder that uses the fixed Huffman codes and only looks for repetitions of the previous pixel and of the
+//  pixel above. This is far from the ratio of zlib, but the rendered thumbnails are mostly flat colors and shrink to
+//  a few percent of their raw size anyway.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef PNG_WRITER_H
+#define PNG_WRITER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// RGB image with 8 bits per channel
+// ------------------------------------------------------------------------------------------------------------------ //
+struct RgbImage {
+
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;      // Rows from top to bottom, 3 bytes (red, green, blue) per pixel
+
+    RgbImage() {}
+
+    // Create an image filled with a gray level
+    RgbImage(int width, int height, unsigned char gray = 255)
+            : width(width), height(height), pixels(std::size_t(3) * width * height, gray) {}
+
+    // Get the address of the first channel of a pixel
+    unsigned char *pixel(int x, int y) { return &pixels[3 * (std::size_t(y) * width + x)]; }
+    const unsigned char *pixel(int x, int y) const { return &pixels[3 * (std::size_t(y) * width + x)]; }
+
+};
+
+
+// Encode the image as the content of a PNG file
+std::string encode_png(const RgbImage &image);
+
+// Write the image to a PNG file
+bool write_png_file(const std::string &file_name, const RgbImage &image);
+
+
+#endif //PNG_WRITER_H
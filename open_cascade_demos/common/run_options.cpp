@@ -0,0 +1,244 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Run options of the demonstration scripts and timing of their stages
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+
+// Include OpenCascade libraries
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+
+// Include the header of this module
+#include "run_options.h"
+#include "demo_models.h"
+#include "mesh_exporter.h"
+#include "thumbnail_renderer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Read the run options
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Read a mesh deflection, which must be a positive number (BRepMesh_IncrementalMesh rejects zero and negative values)
+// The deflection is left unchanged if the text is not a positive number
+static void read_mesh_deflection(const string &text, const string &source, double &mesh_deflection) {
+
+    char *end = nullptr;
+    double deflection = strtod(text.c_str(), &end);
+    if (end == text.c_str() || *end != '\0' || !std::isfinite(deflection) || deflection <= 0.0) {
+        cerr << "Ignoring " << source << "=" << text << ": the mesh deflection must be a positive number (using "
+             << mesh_deflection << ")" << endl;
+        return;
+    }
+    mesh_deflection = deflection;
+
+}
+
+
+RunOptions parse_run_options(int argc, char *argv[]) {
+
+    RunOptions run_options;
+
+    // Read the environment variables
+    const char *value = getenv("DEMO_HEADLESS");
+    if (value != nullptr) { run_options.headless = string(value) == "1"; }
+    value = getenv("DEMO_PREVIEW");
+    if (value != nullptr && *value != '\0') { run_options.preview = value; }
+    value = getenv("DEMO_MESH");
+    if (value != nullptr && *value != '\0') { run_options.mesh = value; }
+    value = getenv("DEMO_MESH_DEFLECTION");
+    if (value != nullptr && *value != '\0') {
+        read_mesh_deflection(value, "DEMO_MESH_DEFLECTION", run_options.mesh_deflection);
+    }
+    value = getenv("DEMO_TIMINGS");
+    if (value != nullptr) { run_options.timings = string(value) == "1"; }
+    value = getenv("DEMO_QUIET");
+    if (value != nullptr) { run_options.quiet = string(value) == "1"; }
+    value = getenv("DEMO_SAMPLES");
+    if (value != nullptr && *value != '\0') { run_options.number_of_samples = atol(value); }
+    value = getenv("DEMO_SAMPLE_FORMAT");
+    if (value != nullptr && *value != '\0') { run_options.sample_format = value; }
+    value = getenv("DEMO_VIEWER");
+    if (value != nullptr && *value != '\0') { run_options.viewer = value; }
+
+    // Read the command line options
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--headless") { run_options.headless = true; }
+        else if (argument.compare(0, 10, "--preview=") == 0) { run_options.preview = argument.substr(10); }
+        else if (argument.compare(0, 7, "--mesh=") == 0) { run_options.mesh = argument.substr(7); }
+        else if (argument.compare(0, 18, "--mesh-deflection=") == 0) {
+            read_mesh_deflection(argument.substr(18), "--mesh-deflection", run_options.mesh_deflection);
+        }
+        else if (argument == "--timings") { run_options.timings = true; }
+        else if (argument == "--quiet") { run_options.quiet = true; }
+        else if (argument.compare(0, 10, "--samples=") == 0) {
+            run_options.number_of_samples = atol(argument.substr(10).c_str());
+        }
+        else if (argument.compare(0, 16, "--sample-format=") == 0) { run_options.sample_format = argument.substr(16); }
+        else if (argument.compare(0, 9, "--viewer=") == 0) { run_options.viewer = argument.substr(9); }
+        else { cerr << "Ignoring unknown option " << argument << endl; }
+    }
+
+    return run_options;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Preview products
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Write a summary of the model (bounding box, topology counts, area and length) as JSON
+static bool write_summary_preview(const string &file_name, const TopoDS_Shape &model_object) {
+
+    // Count the distinct sub-shapes
+    TopTools_IndexedMapOfShape faces, edges, vertices;
+    TopExp::MapShapes(model_object, TopAbs_FACE, faces);
+    TopExp::MapShapes(model_object, TopAbs_EDGE, edges);
+    TopExp::MapShapes(model_object, TopAbs_VERTEX, vertices);
+
+    // Compute the bounding box, the total area and the total length
+    Bnd_Box bounding_box;
+    BRepBndLib::Add(model_object, bounding_box);
+    double x_min = 0, y_min = 0, z_min = 0, x_max = 0, y_max = 0, z_max = 0;
+    if (!bounding_box.IsVoid()) { bounding_box.Get(x_min, y_min, z_min, x_max, y_max, z_max); }
+    GProp_GProps surface_properties, linear_properties;
+    BRepGProp::SurfaceProperties(model_object, surface_properties);
+    BRepGProp::LinearProperties(model_object, linear_properties);
+
+    // Write the summary
+    ofstream summary(file_name);
+    summary << setprecision(12);
+    summary << "{\"faces\": " << faces.Extent() << ", \"edges\": " << edges.Extent()
+            << ", \"vertices\": " << vertices.Extent()
+            << ", \"area\": " << surface_properties.Mass() << ", \"length\": " << linear_properties.Mass()
+            << ", \"bounding_box\": [" << x_min << ", " << y_min << ", " << z_min << ", "
+            << x_max << ", " << y_max << ", " << z_max << "]}" << endl;
+    return !summary.fail();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Visualize the model at the end of a demo
+// ------------------------------------------------------------------------------------------------------------------ //
+void show_model(const RunOptions &run_options, const string &relative_path, const string &model_name,
+                const TopoDS_Shape &model_object) {
+
+    // Read the model from the .step file if the shape is not available
+    TopoDS_Shape shape = model_object;
+    if (shape.IsNull() && (run_options.mesh != "none" || run_options.preview != "none")) {
+        read_step_file(relative_path + model_name + ".step", shape);
+    }
+
+    // Write the triangle meshes next to the .step file (several formats can be separated by commas)
+    if (run_options.mesh != "none") {
+        MeshExportOptions mesh_options;
+        mesh_options.linear_deflection = run_options.mesh_deflection;
+        istringstream mesh_formats(run_options.mesh);
+        string mesh_format;
+        while (getline(mesh_formats, mesh_format, ',')) {
+            MeshExportStats stats;
+            if (shape.IsNull() || !export_mesh(relative_path, model_name, shape, mesh_format, mesh_options, stats)) {
+                cerr << "The " << mesh_format << " mesh of " << model_name << " failed" << endl;
+                continue;
+            }
+            cout << "Meshed " << stats.number_of_triangles << " triangles in " << stats.mesh_seconds << " s ("
+                 << stats.triangles_per_second() << " triangles/s), wrote " << stats.number_of_bytes << " bytes to "
+                 << model_name << "." << mesh_format << " in " << stats.write_seconds << " s" << endl;
+        }
+    }
+
+    // Write the preview products next to the .step file (several types can be separated by commas)
+    if (run_options.preview != "none") {
+        istringstream preview_types(run_options.preview);
+        string preview_type;
+        while (getline(preview_types, preview_type, ',')) {
+            bool is_done = false;
+            if (shape.IsNull()) { cerr << "No model available for the preview" << endl; }
+            else if (preview_type == "summary") {
+                is_done = write_summary_preview(relative_path + model_name + ".summary.json", shape);
+            }
+            else if (preview_type == "png") {
+                is_done = write_thumbnail(relative_path + model_name + ".png", shape);
+            }
+            else { cerr << "Unknown preview type " << preview_type << endl; }
+            if (!is_done) { cerr << "The " << preview_type << " preview of " << model_name << " failed" << endl; }
+        }
+    }
+
+    // Open the .step file in the GUI (this blocks until the GUI is closed)
+    if (run_options.headless) { return; }
+    string open_gui = run_options.viewer + " " + relative_path + model_name + ".step";
+    system(open_gui.c_str());
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Wall-clock timer of the stages of a demo
+// ------------------------------------------------------------------------------------------------------------------ //
+StageTimer::StageTimer(const string &demo_name, bool enabled) : demo_name_(demo_name), enabled_(enabled) {
+
+    demo_start_ = chrono::steady_clock::now();
+
+}
+
+
+void StageTimer::start(const string &stage_name) {
+
+    stop();
+    stage_name_ = stage_name;
+    stage_start_ = chrono::steady_clock::now();
+
+}
+
+
+void StageTimer::stop() {
+
+    if (stage_name_.empty()) { return; }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - stage_start_).count();
+    stages_.push_back(make_pair(stage_name_, seconds));
+    stage_name_.clear();
+
+}
+
+
+void StageTimer::report(ostream &out) {
+
+    stop();
+    if (!enabled_) { return; }
+    double total_seconds = chrono::duration<double>(chrono::steady_clock::now() - demo_start_).count();
+
+    // Print all the timings in a single line, for instance
+    // {"demo": "demo_circle", "stages": {"model": 0.0012, "export": 0.0043}, "total": 0.0055}
+    ostringstream json;
+    json << setprecision(9);
+    json << "{\"demo\": \"" << demo_name_ << "\", \"stages\": {";
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        json << (i > 0 ? ", " : "") << "\"" << stages_[i].first << "\": " << stages_[i].second;
+    }
+    json << "}, \"total\": " << total_seconds << "}";
+    out << json.str() << endl;
+
+}
@@ -0,0 +1,103 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Run options of the demonstration scripts (interactive or headless) and timing of their stages
+//
+//  By default the demos open the exported model in the FreeCAD GUI, which blocks until the GUI is closed. In headless
+//  mode the GUI is never launched, so the demos can be run in batch on machines without a display. Preview products
+//  that do not need a GUI can be written next to the .step file instead: a JSON summary of the model and a PNG
+//  thumbnail drawn by the CPU rasterizer of thumbnail_renderer.h. The model can also be exported as a triangle mesh
+//  (binary STL, OBJ or glTF, see mesh_exporter.h). The wall-clock time of each stage can be printed as one line of
+//  JSON so that a scheduler can collect it. The demos that sample curves or laws can take more samples, write them in
+//  other formats (see sample_writer.h) and skip printing them.
+//
+//  Command line options (each one can also be given through an environment variable):
+//      --headless              DEMO_HEADLESS=1             Do not launch the GUI
+//      --preview=<types>       DEMO_PREVIEW=<types>        Preview products: none (default), summary, png or both
+//      --mesh=<formats>        DEMO_MESH=<formats>         Mesh products: none (default), stl, obj, glb or a list
+//      --mesh-deflection=<d>   DEMO_MESH_DEFLECTION=<d>    Mesh deflection relative to the model size (default 0.001)
+//      --timings               DEMO_TIMINGS=1              Print the timings of the stages as JSON
+//      --quiet                 DEMO_QUIET=1                Do not print the sampled data to the standard output
+//      --samples=<n>           DEMO_SAMPLES=<n>            Number of samples of the sampling demos (0: the demo's)
+//      --sample-format=<f>     DEMO_SAMPLE_FORMAT=<f>      Sample files: csv (default), npy, raw or a list
+//      --viewer=<command>      DEMO_VIEWER=<command>       GUI command (default "FreeCAD --single-instance")
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Options of a run of a demonstration script
+// ------------------------------------------------------------------------------------------------------------------ //
+struct RunOptions {
+    bool headless = false;                              // Do not launch the GUI
+    std::string preview = "none";                       // Types of preview products written next to the .step file
+    std::string mesh = "none";                          // Formats of the triangle meshes written next to the model
+    double mesh_deflection = 0.001;                     // Mesh deflection relative to the size of the model
+    bool timings = false;                               // Print the timings of the stages as JSON
+    bool quiet = false;                                 // Do not print the sampled data to the standard output
+    long number_of_samples = 0;                         // Number of samples of the sampling demos (0: the demo's)
+    std::string sample_format = "csv";                  // Formats of the sample files
+    std::string viewer = "FreeCAD --single-instance";   // Command used to open the .step file in a GUI
+};
+
+
+// Read the run options from the environment and then from the command line (the command line has priority)
+RunOptions parse_run_options(int argc, char *argv[]);
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Visualize the model at the end of a demo
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Write the mesh and preview products and open <relative_path><model_name>.step in the GUI unless running headless
+// The shape can be null (for instance if the export was skipped), in which case it is read from the .step file
+void show_model(const RunOptions &run_options, const std::string &relative_path, const std::string &model_name,
+                const TopoDS_Shape &model_object);
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Wall-clock timer of the stages of a demo
+// ------------------------------------------------------------------------------------------------------------------ //
+class StageTimer {
+
+public:
+
+    // Start timing the demo (nothing is printed if the timer is disabled)
+    StageTimer(const std::string &demo_name, bool enabled);
+
+    // End the current stage (if any) and start a new one
+    void start(const std::string &stage_name);
+
+    // End the current stage and print the timings as a single line of JSON
+    void report(std::ostream &out);
+
+private:
+
+    // End the current stage (if any)
+    void stop();
+
+    std::string demo_name_;
+    bool enabled_;
+    std::chrono::steady_clock::time_point demo_start_;
+    std::chrono::steady_clock::time_point stage_start_;
+    std::string stage_name_;
+    std::vector<std::pair<std::string, double>> stages_;
+
+};
+
+
+#endif //RUN_OPTIONS_H
@@ -0,0 +1,445 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Writer of sampled data (columns of doubles) as CSV, NumPy .npy or raw binary files
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+
+// Include the header of this module
+#include "sample_writer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Buffered writer of a file
+// ------------------------------------------------------------------------------------------------------------------ //
+SampleWriter::SampleWriter(const string &file_name, size_t buffer_size) : buffer_(max(buffer_size, size_t(64))) {
+
+    file_ = fopen(file_name.c_str(), "wb");
+
+}
+
+
+SampleWriter::~SampleWriter() {
+
+    close();
+
+}
+
+
+void SampleWriter::write(const char *data, size_t size) {
+
+    number_of_bytes_ += size;
+
+    // Large blocks bypass the buffer
+    if (size >= buffer_.size()) {
+        flush();
+        if (file_ != nullptr && fwrite(data, 1, size, file_) != size) { failed_ = true; }
+        return;
+    }
+
+    if (used_ + size > buffer_.size()) { flush(); }
+    memcpy(&buffer_[used_], data, size);
+    used_ += size;
+
+}
+
+
+void SampleWriter::write_row(const double *values, int number_of_values) {
+
+    // Format the row in place when it fits in the free part of the buffer (34 characters per value at most)
+    size_t largest_row = size_t(number_of_values) * 34 + 1;
+    if (used_ + largest_row > buffer_.size()) { flush(); }
+    if (largest_row > buffer_.size()) {
+        char text[34];
+        for (int i = 0; i < number_of_values; ++i) {
+            int length = format_shortest(values[i], text);
+            if (i + 1 < number_of_values) { text[length++] = ','; text[length++] = ' '; }
+            write(text, size_t(length));
+        }
+        write("\n", 1);
+        return;
+    }
+
+    char *start = &buffer_[used_], *end = start;
+    for (int i = 0; i < number_of_values; ++i) {
+        end += format_shortest(values[i], end);
+        if (i + 1 < number_of_values) { *end++ = ','; *end++ = ' '; }
+    }
+    *end++ = '\n';
+    used_ += size_t(end - start);
+    number_of_bytes_ += size_t(end - start);
+
+}
+
+
+void SampleWriter::flush() {
+
+    if (file_ != nullptr && used_ > 0 && fwrite(buffer_.data(), 1, used_, file_) != used_) { failed_ = true; }
+    used_ = 0;
+
+}
+
+
+bool SampleWriter::close() {
+
+    if (file_ == nullptr) { return false; }
+    flush();
+    if (fclose(file_) != 0) { failed_ = true; }
+    file_ = nullptr;
+    return !failed_;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Shortest round-trip formatting (Grisu2)
+//
+// The value v lies between the two halfway points m- and m+ to its neighbouring doubles, and any decimal number
+// strictly between them reads back to v. Grisu2 scales the three numbers by a cached power of ten c = 10^-k so that
+// they become 64-bit fixed-point numbers with a few integer bits, and generates the digits of the upper boundary
+// until the remaining part is smaller than the distance between the boundaries. The last digit is then moved towards
+// v. The scaling loses at most one unit in the last place, so the boundaries are narrowed by one unit on each side:
+// the result always reads back to v, and it has the fewest digits except in rare cases (about 0.1% of the doubles)
+// where it has one digit more (see F. Loitsch, "Printing floating-point numbers quickly and accurately with
+// integers", PLDI 2010).
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Number f * 2^e with a 64-bit significand
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+
+// Product of two numbers, rounded to the 64 most significant bits
+static DiyFp multiply(const DiyFp &x, const DiyFp &y) {
+
+    uint64_t x_low = x.f & 0xFFFFFFFFu, x_high = x.f >> 32;
+    uint64_t y_low = y.f & 0xFFFFFFFFu, y_high = y.f >> 32;
+    uint64_t p0 = x_low * y_low, p1 = x_low * y_high, p2 = x_high * y_low, p3 = x_high * y_high;
+    uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu) + (uint64_t(1) << 31);
+    return {p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32), x.e + y.e + 64};
+
+}
+
+
+// Shift the significand until its highest bit is set
+static DiyFp normalize(DiyFp x) {
+
+    while ((x.f >> 63) == 0) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+
+}
+
+
+// Cached powers of ten 10^k = f * 2^e (rounded to the nearest 64-bit significand) for k = -300, -292, ..., 324
+struct CachedPower {
+    uint64_t f;
+    int e;
+    int k;
+};
+
+static const CachedPower CACHED_POWERS[] = {
+        {0xAB70FE17C79AC6CAULL, -1060, -300},
+        {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+        {0xBE5691EF416BD60CULL, -1007, -284},
+        {0x8DD01FAD907FFC3CULL,  -980, -276},
+        {0xD3515C2831559A83ULL,  -954, -268},
+        {0x9D71AC8FADA6C9B5ULL,  -927, -260},
+        {0xEA9C227723EE8BCBULL,  -901, -252},
+        {0xAECC49914078536DULL,  -874, -244},
+        {0x823C12795DB6CE57ULL,  -847, -236},
+        {0xC21094364DFB5637ULL,  -821, -228},
+        {0x9096EA6F3848984FULL,  -794, -220},
+        {0xD77485CB25823AC7ULL,  -768, -212},
+        {0xA086CFCD97BF97F4ULL,  -741, -204},
+        {0xEF340A98172AACE5ULL,  -715, -196},
+        {0xB23867FB2A35B28EULL,  -688, -188},
+        {0x84C8D4DFD2C63F3BULL,  -661, -180},
+        {0xC5DD44271AD3CDBAULL,  -635, -172},
+        {0x936B9FCEBB25C996ULL,  -608, -164},
+        {0xDBAC6C247D62A584ULL,  -582, -156},
+        {0xA3AB66580D5FDAF6ULL,  -555, -148},
+        {0xF3E2F893DEC3F126ULL,  -529, -140},
+        {0xB5B5ADA8AAFF80B8ULL,  -502, -132},
+        {0x87625F056C7C4A8BULL,  -475, -124},
+        {0xC9BCFF6034C13053ULL,  -449, -116},
+        {0x964E858C91BA2655ULL,  -422, -108},
+        {0xDFF9772470297EBDULL,  -396, -100},
+        {0xA6DFBD9FB8E5B88FULL,  -369,  -92},
+        {0xF8A95FCF88747D94ULL,  -343,  -84},
+        {0xB94470938FA89BCFULL,  -316,  -76},
+        {0x8A08F0F8BF0F156BULL,  -289,  -68},
+        {0xCDB02555653131B6ULL,  -263,  -60},
+        {0x993FE2C6D07B7FACULL,  -236,  -52},
+        {0xE45C10C42A2B3B06ULL,  -210,  -44},
+        {0xAA242499697392D3ULL,  -183,  -36},
+        {0xFD87B5F28300CA0EULL,  -157,  -28},
+        {0xBCE5086492111AEBULL,  -130,  -20},
+        {0x8CBCCC096F5088CCULL,  -103,  -12},
+        {0xD1B71758E219652CULL,   -77,   -4},
+        {0x9C40000000000000ULL,   -50,    4},
+        {0xE8D4A51000000000ULL,   -24,   12},
+        {0xAD78EBC5AC620000ULL,     3,   20},
+        {0x813F3978F8940984ULL,    30,   28},
+        {0xC097CE7BC90715B3ULL,    56,   36},
+        {0x8F7E32CE7BEA5C70ULL,    83,   44},
+        {0xD5D238A4ABE98068ULL,   109,   52},
+        {0x9F4F2726179A2245ULL,   136,   60},
+        {0xED63A231D4C4FB27ULL,   162,   68},
+        {0xB0DE65388CC8ADA8ULL,   189,   76},
+        {0x83C7088E1AAB65DBULL,   216,   84},
+        {0xC45D1DF942711D9AULL,   242,   92},
+        {0x924D692CA61BE758ULL,   269,  100},
+        {0xDA01EE641A708DEAULL,   295,  108},
+        {0xA26DA3999AEF774AULL,   322,  116},
+        {0xF209787BB47D6B85ULL,   348,  124},
+        {0xB454E4A179DD1877ULL,   375,  132},
+        {0x865B86925B9BC5C2ULL,   402,  140},
+        {0xC83553C5C8965D3DULL,   428,  148},
+        {0x952AB45CFA97A0B3ULL,   455,  156},
+        {0xDE469FBD99A05FE3ULL,   481,  164},
+        {0xA59BC234DB398C25ULL,   508,  172},
+        {0xF6C69A72A3989F5CULL,   534,  180},
+        {0xB7DCBF5354E9BECEULL,   561,  188},
+        {0x88FCF317F22241E2ULL,   588,  196},
+        {0xCC20CE9BD35C78A5ULL,   614,  204},
+        {0x98165AF37B2153DFULL,   641,  212},
+        {0xE2A0B5DC971F303AULL,   667,  220},
+        {0xA8D9D1535CE3B396ULL,   694,  228},
+        {0xFB9B7CD9A4A7443CULL,   720,  236},
+        {0xBB764C4CA7A44410ULL,   747,  244},
+        {0x8BAB8EEFB6409C1AULL,   774,  252},
+        {0xD01FEF10A657842CULL,   800,  260},
+        {0x9B10A4E5E9913129ULL,   827,  268},
+        {0xE7109BFBA19C0C9DULL,   853,  276},
+        {0xAC2820D9623BF429ULL,   880,  284},
+        {0x80444B5E7AA7CF85ULL,   907,  292},
+        {0xBF21E44003ACDD2DULL,   933,  300},
+        {0x8E679C2F5E44FF8FULL,   960,  308},
+        {0xD433179D9C8CB841ULL,   986,  316},
+        {0x9E19DB92B4E31BA9ULL,  1013,  324},
+};
+
+
+// Generate the digits of a positive, finite value: value = digits * 10^decimal_exponent
+static int grisu2(double value, char *digits, int &decimal_exponent) {
+
+    // Value and halfway points to its neighbours, m- = (v - v_previous) / 2 and m+ = (v + v_next) / 2
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t biased_exponent = bits >> 52, fraction = bits & ((uint64_t(1) << 52) - 1);
+    DiyFp v = biased_exponent == 0 ? DiyFp{fraction, 1 - 1075}
+                                   : DiyFp{fraction + (uint64_t(1) << 52), int(biased_exponent) - 1075};
+    bool lower_boundary_is_closer = fraction == 0 && biased_exponent > 1;
+    DiyFp m_plus = normalize(DiyFp{2 * v.f + 1, v.e - 1});
+    DiyFp m_minus = lower_boundary_is_closer ? DiyFp{4 * v.f - 1, v.e - 2} : DiyFp{2 * v.f - 1, v.e - 1};
+    m_minus = DiyFp{m_minus.f << (m_minus.e - m_plus.e), m_plus.e};
+    v = normalize(v);
+
+    // Scale by a cached power 10^-k so that the binary exponent of the upper boundary lies in [-60, -32]
+    const int alpha = -60;
+    int f = alpha - m_plus.e - 1;
+    int k = (f * 78913) / (1 << 18) + int(f > 0);
+    const CachedPower &cached = CACHED_POWERS[(300 + k + 7) / 8];
+    DiyFp c = {cached.f, cached.e};
+    DiyFp w = multiply(v, c);
+    DiyFp w_minus = multiply(m_minus, c);
+    DiyFp w_plus = multiply(m_plus, c);
+    w_minus.f += 1;
+    w_plus.f -= 1;
+    decimal_exponent = -cached.k;
+
+    // Split the upper boundary into its integer part p1 and its fractional part p2 (one = 2^-e)
+    uint64_t delta = w_plus.f - w_minus.f;
+    uint64_t distance = w_plus.f - w.f;
+    int shift = -w_plus.e;
+    uint64_t one = uint64_t(1) << shift;
+    uint32_t p1 = uint32_t(w_plus.f >> shift);
+    uint64_t p2 = w_plus.f & (one - 1);
+
+    // Integer digits
+    int length = 0;
+    uint32_t power = 1;
+    int n = 1;
+    while (n < 10 && p1 >= power * 10) {
+        power *= 10;
+        n++;
+    }
+    uint64_t rest = 0, unit = 0;
+    bool done = false;
+    while (n > 0) {
+        digits[length++] = char('0' + p1 / power);
+        p1 %= power;
+        n--;
+        rest = (uint64_t(p1) << shift) + p2;
+        if (rest <= delta) {
+            decimal_exponent += n;
+            unit = uint64_t(power) << shift;
+            done = true;
+            break;
+        }
+        power /= 10;
+    }
+
+    // Fractional digits
+    if (!done) {
+        int m = 0;
+        do {
+            p2 *= 10;
+            digits[length++] = char('0' + (p2 >> shift));
+            p2 &= one - 1;
+            m++;
+            delta *= 10;
+            distance *= 10;
+        } while (p2 > delta);
+        decimal_exponent -= m;
+        rest = p2;
+        unit = one;
+    }
+
+    // Move the last digit towards the value while the result stays between the boundaries
+    while (rest < distance && delta - rest >= unit &&
+           (rest + unit < distance || distance - rest > rest + unit - distance)) {
+        digits[length - 1]--;
+        rest += unit;
+    }
+    return length;
+
+}
+
+
+int format_shortest(double value, char *buffer) {
+
+    // Infinities and NaN are rare, so the C library writes them
+    if (!std::isfinite(value)) { return snprintf(buffer, 32, "%g", value); }
+
+    char *out = buffer;
+    if (std::signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        *out++ = '0';
+        return int(out - buffer);
+    }
+
+    // Digits d1 d2 ... dn of the value = 0.d1d2...dn * 10^point
+    char digits[20];
+    int decimal_exponent = 0;
+    int length = grisu2(value, digits, decimal_exponent);
+    int point = length + decimal_exponent;
+
+    // Positional notation for 1e-4 <= value < 1e15 (as %g), scientific notation otherwise
+    if (length <= point && point <= 15) {
+        memcpy(out, digits, size_t(length));
+        memset(out + length, '0', size_t(point - length));
+        out += point;
+    } else if (0 < point && point <= 15) {
+        memcpy(out, digits, size_t(point));
+        out[point] = '.';
+        memcpy(out + point + 1, digits + point, size_t(length - point));
+        out += length + 1;
+    } else if (-4 < point && point <= 0) {
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', size_t(-point));
+        memcpy(out - point, digits, size_t(length));
+        out += length - point;
+    } else {
+        *out++ = digits[0];
+        if (length > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, size_t(length - 1));
+            out += length - 1;
+        }
+        int exponent = point - 1;
+        *out++ = 'e';
+        *out++ = exponent < 0 ? '-' : '+';
+        exponent = abs(exponent);
+        if (exponent >= 100) { *out++ = char('0' + exponent / 100); }
+        *out++ = char('0' + exponent / 10 % 10);
+        *out++ = char('0' + exponent % 10);
+    }
+    return int(out - buffer);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write columns of samples
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Header of a NumPy .npy file (version 1.0) for a float64 array of shape (rows, columns), padded to 64 bytes
+static string make_npy_header(size_t rows, size_t columns) {
+
+    uint16_t probe = 1;
+    unsigned char first_byte;
+    memcpy(&first_byte, &probe, 1);
+    string descr = first_byte == 1 ? "<f8" : ">f8";
+
+    string dictionary = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" + to_string(rows) + ", " +
+                        to_string(columns) + "), }";
+
+    // Magic string (6 bytes), version (2 bytes), header length (2 bytes, little-endian), dictionary, padding, newline
+    size_t total = 10 + dictionary.size() + 1;
+    dictionary.append((64 - total % 64) % 64, ' ');
+    dictionary.push_back('\n');
+    size_t header_length = dictionary.size();
+
+    string header("\x93NUMPY\x01\x00", 8);
+    header.push_back(char(header_length & 0xff));
+    header.push_back(char((header_length >> 8) & 0xff));
+    return header + dictionary;
+
+}
+
+
+bool write_samples(const string &file_name, const string &format, const vector<const double *> &columns,
+                   size_t number_of_samples, size_t *number_of_bytes) {
+
+    if (format != "csv" && format != "npy" && format != "raw") { return false; }
+    SampleWriter writer(file_name);
+    if (!writer.is_open()) { return false; }
+
+    if (format == "csv") {
+
+        // Gather the values of each sample into one row
+        vector<double> row(columns.size());
+        for (size_t i = 0; i < number_of_samples; ++i) {
+            for (size_t c = 0; c < columns.size(); ++c) { row[c] = columns[c][i]; }
+            writer.write_row(row.data(), int(row.size()));
+        }
+
+    } else {
+
+        // The columns are already contiguous arrays of doubles, so they are written as they are
+        if (format == "npy") {
+            string header = make_npy_header(columns.size(), number_of_samples);
+            writer.write(header.data(), header.size());
+        }
+        for (const double *column : columns) {
+            writer.write(reinterpret_cast<const char *>(column), number_of_samples * sizeof(double));
+        }
+
+    }
+
+    if (number_of_bytes != nullptr) { *number_of_bytes = writer.number_of_bytes(); }
+    return writer.close();
+
+}
@@ -0,0 +1,89 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Writer of sampled data (columns of doubles) as CSV, NumPy .npy or raw binary files
+//
+//  Writing samples with an ofstream and endl flushes the stream on every row, and formatting each value through the
+//  locale machinery of the stream is slow as well. For 10^6 to 10^8 samples the writer keeps its own output buffer
+//  and only hands full buffers to the operating system:
+//
+//      - csv: one row per sample with the values separated by ", " (the format read by numpy.loadtxt). Each value is
+//        written with the fewest significant digits that read back to the same double (shortest round trip, up to
+//        one extra digit for a small fraction of the values), which keeps values such as 0.01 short without losing
+//        precision on any value. The digits are generated with 64-bit integer arithmetic (the Grisu2 algorithm)
+//        instead of the C library, whose printf and strtod are several times slower.
+//      - npy: NumPy format version 1.0 with a float64 array of shape (number_of_columns, number_of_samples), so that
+//        numpy.load(file, mmap_mode='r') maps the file and returns one row per column without parsing any text. The
+//        header is padded to 64 bytes so that the data is aligned in the mapped file.
+//      - raw: the same float64 values without any header (column after column, in the byte order of the machine),
+//        for numpy.fromfile or numpy.memmap when the shape is known.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef SAMPLE_WRITER_H
+#define SAMPLE_WRITER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Buffered writer of a file
+// ------------------------------------------------------------------------------------------------------------------ //
+class SampleWriter {
+
+public:
+
+    // Open the file for writing (check is_open before writing)
+    explicit SampleWriter(const std::string &file_name, std::size_t buffer_size = std::size_t(1) << 20);
+
+    // The buffer is written and the file is closed if close was not called
+    ~SampleWriter();
+
+    SampleWriter(const SampleWriter &) = delete;
+    SampleWriter &operator=(const SampleWriter &) = delete;
+
+    bool is_open() const { return file_ != nullptr; }
+
+    // Append bytes to the file
+    void write(const char *data, std::size_t size);
+
+    // Append one CSV row with the values separated by ", " and ended by a newline
+    void write_row(const double *values, int number_of_values);
+
+    // Write the buffer and close the file (returns false if any write failed)
+    bool close();
+
+    // Number of bytes appended so far
+    std::size_t number_of_bytes() const { return number_of_bytes_; }
+
+private:
+
+    // Hand the buffer to the operating system
+    void flush();
+
+    std::FILE *file_ = nullptr;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::size_t number_of_bytes_ = 0;
+    bool failed_ = false;
+
+};
+
+
+// Write a decimal representation of the value that reads back to the same double, with the fewest digits except in
+// rare cases where Grisu2 gives one digit more (the buffer needs room for 32 characters, no terminating null is
+// written) and return its number of characters
+int format_shortest(double value, char *buffer);
+
+
+// Write the columns of samples (all of them with number_of_samples values) in the given format: csv, npy or raw
+// Return false if the format is unknown or the file could not be written, and set the number of bytes written
+bool write_samples(const std::string &file_name, const std::string &format, const std::vector<const double *> &columns,
+                   std::size_t number_of_samples, std::size_t *number_of_bytes = nullptr);
+
+
+#endif //SAMPLE_WRITER_H
@@ -0,0 +1,126 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Perforation of a solid disk by a boolean cut of cylinders
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <cmath>
+#include <map>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pln.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Wire.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakePrism.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+
+
+// Include the header of this module
+#include "solid_perforation.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Solid annulus extruded from the XY plane
+// ------------------------------------------------------------------------------------------------------------------ //
+static TopoDS_Shape make_annular_solid(const AnnularRegion &region, double thickness) {
+
+    gp_Ax2 axes(gp_Pnt(region.x_center, region.y_center, 0.0), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+    TopoDS_Wire outer_wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, region.outer_radius)));
+    BRepBuilderAPI_MakeFace face_maker(gp_Pln(), outer_wire);
+    if (region.inner_radius > 0.0) {
+        TopoDS_Wire inner_wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(axes, region.inner_radius)));
+        face_maker.Add(TopoDS::Wire(inner_wire.Reversed()));
+    }
+    return BRepPrimAPI_MakePrism(face_maker.Face(), gp_Vec(0.0, 0.0, thickness)).Shape();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Extrude the annulus and cut all the holes out of it in a single boolean operation
+// ------------------------------------------------------------------------------------------------------------------ //
+TopoDS_Shape make_perforated_solid(const AnnularRegion &region, const vector<HoleDescriptor> &holes,
+                                   const SolidPerforationOptions &options, SolidPerforationStats *stats) {
+
+    SolidPerforationStats local_stats;
+    SolidPerforationStats &result = stats != nullptr ? *stats : local_stats;
+    result = SolidPerforationStats();
+    if (!(region.outer_radius > region.inner_radius) || !(options.thickness > 0.0)) { return TopoDS_Shape(); }
+
+    // Solid disk
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    TopoDS_Shape solid = make_annular_solid(region, options.thickness);
+    Bnd_Box solid_box;
+    BRepBndLib::Add(solid, solid_box);
+
+    // The cylinders go through the disk, so that their end faces do not lie on the faces of the disk
+    double margin = 0.1 * options.thickness;
+    double height = options.thickness + 2.0 * margin;
+    map<double, TopoDS_Shape> prototypes;
+    TopTools_ListOfShape tools;
+    for (const HoleDescriptor &hole : holes) {
+        if (!(hole.radius > 0.0)) { continue; }
+        result.number_of_tools++;
+
+        // Drop the tools that cannot touch the solid
+        if (options.prefilter) {
+            Bnd_Box tool_box;
+            tool_box.Update(hole.x - hole.radius, hole.y - hole.radius, -margin,
+                            hole.x + hole.radius, hole.y + hole.radius, options.thickness + margin);
+            double distance = hypot(hole.x - region.x_center, hole.y - region.y_center);
+            bool is_in_central_hole = distance + hole.radius <= region.inner_radius;
+            bool is_outside = distance - hole.radius >= region.outer_radius;
+            if (tool_box.IsOut(solid_box) || is_in_central_hole || is_outside) { continue; }
+        }
+
+        // Located instance of the cylinder of the radius of the hole
+        auto prototype = prototypes.find(hole.radius);
+        if (prototype == prototypes.end()) {
+            gp_Ax2 axes(gp_Pnt(0.0, 0.0, -margin), gp_Dir(0, 0, 1), gp_Dir(1, 0, 0));
+            TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(axes, hole.radius, height).Shape();
+            prototype = prototypes.insert(make_pair(hole.radius, cylinder)).first;
+        }
+        tools.Append(prototype->second.Moved(TopLoc_Location(hole_transformation(hole))));
+    }
+    result.number_of_cut_tools = size_t(tools.Extent());
+    result.tool_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (tools.IsEmpty()) { return solid; }
+
+    // Cut all the tools at once
+    start = chrono::steady_clock::now();
+    TopTools_ListOfShape arguments;
+    arguments.Append(solid);
+    BRepAlgoAPI_Cut cut;
+    cut.SetArguments(arguments);
+    cut.SetTools(tools);
+    cut.SetRunParallel(options.parallel);
+    if (options.fuzzy_value > 0.0) { cut.SetFuzzyValue(options.fuzzy_value); }
+    cut.Build();
+    result.cut_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (!cut.IsDone() || cut.HasErrors()) { return TopoDS_Shape(); }
+    result.has_warnings = cut.HasWarnings();
+    return cut.Shape();
+
+}
@@ -0,0 +1,64 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Perforation of a solid disk by a boolean cut of cylinders
+//
+//  Instead of adding the holes as inner wires of a planar face (see hole_pattern.h), the annulus is extruded into a
+//  solid and the holes are cut out of it with cylinders. Cutting the cylinders one at a time repeats the intersection
+//  of the solid with all the previous tools, so all the cylinders are passed to a single BRepAlgoAPI_Cut with several
+//  tools, and the boolean engine runs in parallel mode (the intersection of the pairs of shapes is split among
+//  threads). The cylinders of the same radius are located instances of one prototype, like the hole wires.
+//
+//  The optional prefilter drops the tools that cannot touch the solid before the boolean operation: the cylinders
+//  whose bounding boxes are out of the bounding box of the solid, and the cylinders that lie inside the central hole
+//  or outside the outer circle of the annulus.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef SOLID_PERFORATION_H
+#define SOLID_PERFORATION_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Include the shared demo library
+#include "hole_pattern.h"
+#include "hole_validator.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Options of the perforation
+// ------------------------------------------------------------------------------------------------------------------ //
+struct SolidPerforationOptions {
+    double thickness = 0.1;             // Thickness of the disk (extruded in the +Z direction from the XY plane)
+    bool parallel = true;               // Run the boolean operation in parallel mode
+    bool prefilter = true;              // Drop the tools that cannot touch the solid before the boolean operation
+    double fuzzy_value = 0.0;           // Additional tolerance of the boolean operation (zero to disable it)
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the perforation
+// ------------------------------------------------------------------------------------------------------------------ //
+struct SolidPerforationStats {
+    std::size_t number_of_tools = 0;        // Number of cylinders built (one per hole)
+    std::size_t number_of_cut_tools = 0;    // Number of cylinders passed to the boolean operation
+    double tool_seconds = 0.0;              // Wall-clock time spent building the solid and the cylinders
+    double cut_seconds = 0.0;               // Wall-clock time spent in the boolean operation
+    bool has_warnings = false;              // The boolean operation reported warnings
+};
+
+
+// Extrude the annulus and cut all the holes out of it in a single boolean operation (returns a null shape on failure)
+TopoDS_Shape make_perforated_solid(const AnnularRegion &region, const std::vector<HoleDescriptor> &holes,
+                                   const SolidPerforationOptions &options = SolidPerforationOptions(),
+                                   SolidPerforationStats *stats = nullptr);
+
+
+#endif //SOLID_PERFORATION_H
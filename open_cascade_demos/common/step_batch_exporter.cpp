@@ -0,0 +1,86 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Parallel batch export of many shapes to STEP files
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <ctime>
+#include <memory>
+
+
+// Include OpenCascade libraries
+#include <STEPControl_Controller.hxx>
+
+
+// Include the header of this module
+#include "step_batch_exporter.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Current date and time in the format used by the header of STEP files
+// ------------------------------------------------------------------------------------------------------------------ //
+string current_step_time_stamp() {
+
+    time_t now = time(nullptr);
+    tm local_time;
+    localtime_r(&now, &local_time);
+    char buffer[32];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &local_time);
+    return string(buffer);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write every job to its own .step file using a pool of worker threads
+// ------------------------------------------------------------------------------------------------------------------ //
+StepBatchResult
+write_step_batch(const string &relative_path, const vector<StepExportJob> &jobs, int number_of_threads,
+                 const string &time_stamp, STEPControl_StepModelType step_mode) {
+
+    StepBatchResult result;
+    result.statuses.assign(jobs.size(), IFSelect_RetVoid);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // The static part of the STEP translator is not thread-safe, so it is initialized before the workers start
+    STEPControl_Controller::Init();
+
+    // Create one exporter per worker (the writers are created serially for the same reason)
+    number_of_threads = resolve_number_of_threads(number_of_threads);
+    if (size_t(number_of_threads) > jobs.size()) { number_of_threads = max(int(jobs.size()), 1); }
+    string batch_time_stamp = time_stamp.empty() ? current_step_time_stamp() : time_stamp;
+    vector<unique_ptr<StepExporter>> exporters;
+    for (int k = 0; k < number_of_threads; ++k) {
+        exporters.emplace_back(new StepExporter(step_mode));
+        exporters.back()->set_time_stamp(batch_time_stamp);
+    }
+
+    // Each worker translates and writes the jobs it picks with its own exporter
+    parallel_for_workers(jobs.size(), number_of_threads, [&](int worker_index, size_t i) {
+        result.statuses[i] = exporters[worker_index]->write(relative_path, jobs[i].model_name, jobs[i].model_object);
+    });
+
+    // Gather the statistics of the workers
+    for (const unique_ptr<StepExporter> &exporter : exporters) {
+        result.timings.transfer_seconds += exporter->timings().transfer_seconds;
+        result.timings.write_seconds += exporter->timings().write_seconds;
+        result.timings.number_of_files += exporter->timings().number_of_files;
+        result.timings.number_of_shapes += exporter->timings().number_of_shapes;
+    }
+    for (IFSelect_ReturnStatus status : result.statuses) {
+        if (status != IFSelect_RetDone) { result.number_of_failures++; }
+    }
+    result.number_of_threads = number_of_threads;
+    result.wall_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    return result;
+
+}
@@ -0,0 +1,68 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Parallel batch export of many shapes to STEP files
+//
+//  The jobs are distributed over a pool of worker threads. Every worker owns its own StepExporter (and therefore its
+//  own STEPControl_Writer and work session), so no translator state is shared between threads. All the files of a
+//  batch get the same header time stamp, which makes the output byte-identical to a serial StepExporter that uses
+//  the same time stamp.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef STEP_BATCH_EXPORTER_H
+#define STEP_BATCH_EXPORTER_H
+
+
+// Include standard C++ libraries
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+#include <IFSelect_ReturnStatus.hxx>
+#include <STEPControl_StepModelType.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// One entry of the batch: the shape is written to <relative_path><model_name>.step
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepExportJob {
+    std::string model_name;
+    TopoDS_Shape model_object;
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Outcome of a batch export
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepBatchResult {
+    std::vector<IFSelect_ReturnStatus> statuses;    // Status of each job (same order as the jobs)
+    StepExportTimings timings;                      // Transfer and Write times summed over all the workers
+    double wall_seconds = 0.0;                      // Elapsed time of the whole batch
+    int number_of_threads = 0;                      // Number of worker threads used
+    int number_of_failures = 0;                     // Number of jobs that did not return IFSelect_RetDone
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Current date and time in the format used by the header of STEP files (for instance 2020-05-12T10:24:31)
+// ------------------------------------------------------------------------------------------------------------------ //
+std::string current_step_time_stamp();
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Write every job to its own .step file using number_of_threads workers (zero means one per hardware core)
+// If time_stamp is empty, the time at which the batch starts is used for all the files
+// ------------------------------------------------------------------------------------------------------------------ //
+StepBatchResult
+write_step_batch(const std::string &relative_path, const std::vector<StepExportJob> &jobs, int number_of_threads = 0,
+                 const std::string &time_stamp = "",
+                 STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs);
+
+
+#endif //STEP_BATCH_EXPORTER_H
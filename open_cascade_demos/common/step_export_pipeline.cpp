@@ -0,0 +1,185 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Asynchronous STEP export pipeline
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+
+// Include OpenCascade libraries
+#include <Standard_Failure.hxx>
+#include <STEPControl_Controller.hxx>
+
+
+// Include the header of this module
+#include "step_export_pipeline.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Elapsed time in seconds since a given time point
+// ------------------------------------------------------------------------------------------------------------------ //
+static double seconds_since(const chrono::steady_clock::time_point &start) {
+
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Producer/consumer pipeline
+// ------------------------------------------------------------------------------------------------------------------ //
+StepExportPipeline::StepExportPipeline(const string &relative_path, size_t queue_capacity, int number_of_writers,
+                                       STEPControl_StepModelType step_mode)
+        : relative_path_(relative_path), queue_capacity_(max(queue_capacity, size_t(1))) {
+
+    // The static part of the STEP translator is initialized before the writer threads start
+    STEPControl_Controller::Init();
+
+    // Create one exporter per writer thread and start the writers
+    number_of_writers = max(number_of_writers, 1);
+    for (int k = 0; k < number_of_writers; ++k) { exporters_.emplace_back(new StepExporter(step_mode)); }
+    for (int k = 0; k < number_of_writers; ++k) { writers_.emplace_back(&StepExportPipeline::writer_loop, this, k); }
+
+}
+
+
+StepExportPipeline::~StepExportPipeline() {
+
+    join();
+
+}
+
+
+void StepExportPipeline::push(const string &model_name, const TopoDS_Shape &model_object) {
+
+    unique_lock<mutex> lock(mutex_);
+    if (stopping_) { throw logic_error("StepExportPipeline::push called after join"); }
+
+    // Wait for a free slot in the queue (back-pressure on the producer)
+    if (queue_.size() >= queue_capacity_) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        queue_not_full_.wait(lock, [this] { return queue_.size() < queue_capacity_; });
+        stats_.producer_stall_seconds += seconds_since(start);
+    }
+
+    // Queue the job and record the depth of the queue
+    StepExportJob job;
+    job.model_name = model_name;
+    job.model_object = model_object;
+    queue_.push_back(job);
+    stats_.number_of_jobs++;
+    stats_.max_queue_depth = max(stats_.max_queue_depth, queue_.size());
+    queue_depth_sum_ += queue_.size();
+
+    // Wake up one writer
+    lock.unlock();
+    queue_not_empty_.notify_one();
+
+}
+
+
+void StepExportPipeline::flush() {
+
+    unique_lock<mutex> lock(mutex_);
+    queue_drained_.wait(lock, [this] { return queue_.empty() && jobs_in_progress_ == 0; });
+
+}
+
+
+void StepExportPipeline::join() {
+
+    // Let the writers finish the pending jobs and then stop them
+    {
+        lock_guard<mutex> lock(mutex_);
+        if (stopping_) { return; }
+        stopping_ = true;
+    }
+    queue_not_empty_.notify_all();
+    for (thread &writer : writers_) { writer.join(); }
+
+}
+
+
+void StepExportPipeline::writer_loop(int writer_index) {
+
+    StepExporter &step_exporter = *exporters_[writer_index];
+
+    for (;;) {
+
+        // Wait for a job (or for the pipeline to stop once the queue is empty)
+        unique_lock<mutex> lock(mutex_);
+        chrono::steady_clock::time_point idle_start = chrono::steady_clock::now();
+        queue_not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+        stats_.writer_idle_seconds += seconds_since(idle_start);
+        if (queue_.empty()) { return; }
+
+        // Take the job out of the queue and release a slot for the producer
+        StepExportJob job = queue_.front();
+        queue_.pop_front();
+        jobs_in_progress_++;
+        lock.unlock();
+        queue_not_full_.notify_one();
+
+        // Write the .step file without holding the lock
+        // An exception must not escape the thread (std::terminate) or skip the bookkeeping below (flush() would wait
+        // forever), so it is counted as a failed job
+        chrono::steady_clock::time_point busy_start = chrono::steady_clock::now();
+        IFSelect_ReturnStatus status = IFSelect_RetFail;
+        try {
+            status = step_exporter.write(relative_path_, job.model_name, job.model_object);
+        }
+        catch (const Standard_Failure &failure) {
+            cerr << "Writing " << job.model_name << ".step failed: " << failure.GetMessageString() << endl;
+        }
+        catch (const exception &error) {
+            cerr << "Writing " << job.model_name << ".step failed: " << error.what() << endl;
+        }
+        double busy_seconds = seconds_since(busy_start);
+
+        // Record the result and notify flush() when everything has been written
+        lock.lock();
+        jobs_in_progress_--;
+        stats_.writer_busy_seconds += busy_seconds;
+        if (status != IFSelect_RetDone) { stats_.number_of_failures++; }
+        bool drained = queue_.empty() && jobs_in_progress_ == 0;
+        lock.unlock();
+        if (drained) { queue_drained_.notify_all(); }
+
+    }
+
+}
+
+
+StepPipelineStats StepExportPipeline::stats() const {
+
+    lock_guard<mutex> lock(mutex_);
+    StepPipelineStats stats = stats_;
+    if (stats.number_of_jobs > 0) { stats.mean_queue_depth = double(queue_depth_sum_) / stats.number_of_jobs; }
+    return stats;
+
+}
+
+
+void StepExportPipeline::print_stats(ostream &out) const {
+
+    StepPipelineStats stats = this->stats();
+    out << "\n\nSTEP export pipeline statistics" << endl;
+    out << setw(30) << "Jobs" << setw(20) << stats.number_of_jobs << endl;
+    out << setw(30) << "Failures" << setw(20) << stats.number_of_failures << endl;
+    out << setw(30) << "Max queue depth" << setw(20) << stats.max_queue_depth << endl;
+    out << setw(30) << "Mean queue depth" << setw(20) << stats.mean_queue_depth << endl;
+    out << setw(30) << "Producer stall [s]" << setw(20) << stats.producer_stall_seconds << endl;
+    out << setw(30) << "Writer idle [s]" << setw(20) << stats.writer_idle_seconds << endl;
+    out << setw(30) << "Writer busy [s]" << setw(20) << stats.writer_busy_seconds << endl;
+
+}
@@ -0,0 +1,107 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Asynchronous STEP export pipeline
+//
+//  The modelling code (producer) pushes finished shapes into a bounded queue and carries on with the next model,
+//  while background writer threads drain the queue to disk. When the queue is full, push() blocks until a writer
+//  takes a job (back-pressure), so the memory used by pending shapes stays bounded. Every writer thread owns its own
+//  StepExporter, as in write_step_batch().
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef STEP_EXPORT_PIPELINE_H
+#define STEP_EXPORT_PIPELINE_H
+
+
+// Include standard C++ libraries
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+#include <STEPControl_StepModelType.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+#include "step_batch_exporter.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the pipeline
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepPipelineStats {
+    std::size_t number_of_jobs = 0;         // Number of shapes pushed into the queue
+    std::size_t max_queue_depth = 0;        // Largest number of pending jobs seen by push()
+    double mean_queue_depth = 0.0;          // Mean number of pending jobs seen by push()
+    double producer_stall_seconds = 0.0;    // Time that push() was blocked because the queue was full
+    double writer_idle_seconds = 0.0;       // Time that the writers waited for jobs (summed over the writers)
+    double writer_busy_seconds = 0.0;       // Time that the writers spent exporting (summed over the writers)
+    int number_of_failures = 0;             // Number of jobs that did not return IFSelect_RetDone or that threw
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Producer/consumer pipeline that writes the shapes to <relative_path><model_name>.step
+// ------------------------------------------------------------------------------------------------------------------ //
+class StepExportPipeline {
+
+public:
+
+    // Start the writer threads (the queue holds at most queue_capacity pending shapes)
+    StepExportPipeline(const std::string &relative_path, std::size_t queue_capacity = 16, int number_of_writers = 1,
+                       STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs);
+
+    // Join the writer threads if join() was not called explicitly
+    ~StepExportPipeline();
+
+    // The pipeline owns threads and cannot be copied
+    StepExportPipeline(const StepExportPipeline &) = delete;
+    StepExportPipeline &operator=(const StepExportPipeline &) = delete;
+
+    // Queue a shape for export (blocks while the queue is full)
+    void push(const std::string &model_name, const TopoDS_Shape &model_object);
+
+    // Wait until every shape pushed so far has been written
+    void flush();
+
+    // Write the pending shapes and stop the writer threads (no shapes can be pushed afterwards)
+    void join();
+
+    // Get and print the statistics of the pipeline
+    StepPipelineStats stats() const;
+    void print_stats(std::ostream &out) const;
+
+private:
+
+    // Loop executed by each writer thread
+    void writer_loop(int writer_index);
+
+    std::string relative_path_;
+    std::size_t queue_capacity_;
+    std::deque<StepExportJob> queue_;
+    std::size_t jobs_in_progress_ = 0;
+    bool stopping_ = false;
+    std::size_t queue_depth_sum_ = 0;
+    StepPipelineStats stats_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queue_not_full_;
+    std::condition_variable queue_not_empty_;
+    std::condition_variable queue_drained_;
+
+    std::vector<std::unique_ptr<StepExporter>> exporters_;
+    std::vector<std::thread> writers_;
+
+};
+
+
+#endif //STEP_EXPORT_PIPELINE_H
@@ -0,0 +1,153 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Shared STEP exporter used by all the demonstration scripts
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <sys/stat.h>
+
+
+// Include OpenCascade libraries
+#include <APIHeaderSection_MakeHeader.hxx>
+#include <TCollection_HAsciiString.hxx>
+#include <XSControl_WorkSession.hxx>
+#include <TopoDS_Compound.hxx>
+#include <BRep_Builder.hxx>
+
+
+// Include the header of this module
+#include "step_exporter.h"
+#include "brep_cache.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Step file exporter with a warm writer session
+// ------------------------------------------------------------------------------------------------------------------ //
+StepExporter::StepExporter(STEPControl_StepModelType step_mode) : step_mode_(step_mode) {}
+
+
+IFSelect_ReturnStatus
+StepExporter::write(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
+
+    return write(relative_path, model_name, vector<TopoDS_Shape>(1, model_object));
+
+}
+
+
+IFSelect_ReturnStatus
+StepExporter::write(const string &relative_path, const string &model_name, const vector<TopoDS_Shape> &model_objects) {
+
+    // Create the output directory if it does not exist
+    make_directory(relative_path);
+
+    // Get the full path to the step file
+    string file_name = relative_path + model_name + ".step";
+
+    // Forget the shapes of the previous file and start a new STEP model within the same work session
+    step_writer_.WS()->ClearData(5);
+    step_writer_.Model(Standard_True);
+
+    // Transfer the shapes to the STEP model
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    IFSelect_ReturnStatus status = IFSelect_RetVoid;
+    for (const TopoDS_Shape &model_object : model_objects) {
+        status = step_writer_.Transfer(model_object, step_mode_);
+        if (status != IFSelect_RetDone) { return status; }
+        timings_.number_of_shapes++;
+    }
+    chrono::steady_clock::time_point transferred = chrono::steady_clock::now();
+
+    // Overwrite the time stamp of the file header to make the output reproducible
+    if (!time_stamp_.empty()) {
+        APIHeaderSection_MakeHeader header(step_writer_.Model());
+        header.SetTimeStamp(new TCollection_HAsciiString(time_stamp_.c_str()));
+    }
+
+    // Write the .step file
+    status = step_writer_.Write(file_name.c_str());
+    chrono::steady_clock::time_point written = chrono::steady_clock::now();
+
+    // Write the binary BRep cache next to the .step file (several shapes are stored as a compound)
+    if (write_brep_cache_ && status == IFSelect_RetDone) {
+        TopoDS_Shape cache_object = model_objects.size() == 1 ? model_objects[0] : TopoDS_Shape();
+        if (model_objects.size() > 1) {
+            TopoDS_Compound compound;
+            BRep_Builder builder;
+            builder.MakeCompound(compound);
+            for (const TopoDS_Shape &model_object : model_objects) { builder.Add(compound, model_object); }
+            cache_object = compound;
+        }
+        if (!write_brep_file(relative_path, model_name, cache_object)) { status = IFSelect_RetFail; }
+        timings_.brep_cache_seconds += chrono::duration<double>(chrono::steady_clock::now() - written).count();
+    }
+
+    // Update the timings
+    timings_.transfer_seconds += chrono::duration<double>(transferred - start).count();
+    timings_.write_seconds += chrono::duration<double>(written - transferred).count();
+    timings_.number_of_files++;
+
+    return status;
+
+}
+
+
+void StepExporter::print_timings(ostream &out) const {
+
+    out << "\n\nSTEP export timings" << endl;
+    out << setw(20) << "Files" << setw(20) << timings_.number_of_files << endl;
+    out << setw(20) << "Shapes" << setw(20) << timings_.number_of_shapes << endl;
+    out << setw(20) << "Transfer [s]" << setw(20) << timings_.transfer_seconds << endl;
+    out << setw(20) << "Write [s]" << setw(20) << timings_.write_seconds << endl;
+    if (write_brep_cache_) { out << setw(20) << "BRep cache [s]" << setw(20) << timings_.brep_cache_seconds << endl; }
+
+}
+
+
+void StepExporter::make_directory(const string &relative_path) {
+
+    // Skip the system call if the directory was already created by this exporter
+    if (created_directories_.count(relative_path) > 0) { return; }
+
+    // Create the output directory if it does not exist
+    mkdir(relative_path.c_str(), 0777);     // 0777 is used to give the user permissions to read+write+execute
+    created_directories_.insert(relative_path);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Convenience interface used by the demonstration scripts
+// ------------------------------------------------------------------------------------------------------------------ //
+StepExporter &default_step_exporter() {
+
+    // The exporter is created on first use and lives until the end of the process
+    static StepExporter step_exporter;
+
+    // Read the options of the exporter from the environment (only once)
+    static bool is_configured = [] {
+        const char *brep_cache = getenv("DEMO_BREP_CACHE");
+        step_exporter.set_write_brep_cache(brep_cache != nullptr && string(brep_cache) == "1");
+        return true;
+    }();
+    (void) is_configured;
+
+    return step_exporter;
+
+}
+
+
+IFSelect_ReturnStatus
+write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
+
+    return default_step_exporter().write(relative_path, model_name, model_object);
+
+}
@@ -0,0 +1,105 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Shared STEP exporter used by all the demonstration scripts
+//
+//  Creating a STEPControl_Writer initializes the STEP translator and opens a new work session, which is much more
+//  expensive than translating a small part. The StepExporter keeps a single writer (and therefore a single session)
+//  alive and starts a fresh STEP model for every file, so that thousands of models can be written in a row without
+//  re-initializing the STEP interface.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef STEP_EXPORTER_H
+#define STEP_EXPORTER_H
+
+
+// Include standard C++ libraries
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+#include <IFSelect_ReturnStatus.hxx>
+#include <STEPControl_StepModelType.hxx>
+#include <STEPControl_Writer.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Accumulated wall-clock time spent in each stage of the export
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepExportTimings {
+    double transfer_seconds = 0.0;      // Time spent in STEPControl_Writer::Transfer
+    double write_seconds = 0.0;         // Time spent in STEPControl_Writer::Write
+    double brep_cache_seconds = 0.0;    // Time spent writing the binary BRep cache (if enabled)
+    int number_of_files = 0;            // Number of .step files written
+    int number_of_shapes = 0;           // Number of shapes transferred
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Step file exporter with a warm writer session
+// ------------------------------------------------------------------------------------------------------------------ //
+class StepExporter {
+
+public:
+
+    // Create the writer session once (the type of .step representation is shared by all the files)
+    explicit StepExporter(STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs);
+
+    // Write one shape to the file <relative_path><model_name>.step
+    IFSelect_ReturnStatus write(const std::string &relative_path, const std::string &model_name,
+                                const TopoDS_Shape &model_object);
+
+    // Write several shapes as independent roots of the file <relative_path><model_name>.step
+    IFSelect_ReturnStatus write(const std::string &relative_path, const std::string &model_name,
+                                const std::vector<TopoDS_Shape> &model_objects);
+
+    // Type of .step representation used for all the files
+    STEPControl_StepModelType step_mode() const { return step_mode_; }
+
+    // Use a fixed time stamp in the header of the files (by default the current time is used)
+    // Two exporters with the same time stamp write byte-identical files for the same shapes
+    void set_time_stamp(const std::string &time_stamp) { time_stamp_ = time_stamp; }
+    const std::string &time_stamp() const { return time_stamp_; }
+
+    // Also write the shapes to a binary BRep file next to each .step file (see brep_cache.h)
+    void set_write_brep_cache(bool write_brep_cache) { write_brep_cache_ = write_brep_cache; }
+    bool write_brep_cache() const { return write_brep_cache_; }
+
+    // Get, reset and print the accumulated timings of the Transfer and Write stages
+    const StepExportTimings &timings() const { return timings_; }
+    void reset_timings() { timings_ = StepExportTimings(); }
+    void print_timings(std::ostream &out) const;
+
+private:
+
+    // Create the output directory only the first time it is used
+    void make_directory(const std::string &relative_path);
+
+    STEPControl_Writer step_writer_;
+    STEPControl_StepModelType step_mode_;
+    StepExportTimings timings_;
+    std::string time_stamp_;
+    bool write_brep_cache_ = false;
+    std::set<std::string> created_directories_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Convenience interface used by the demonstration scripts
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Exporter shared by the whole process (created the first time it is used)
+// The binary BRep cache is enabled by setting the environment variable DEMO_BREP_CACHE=1
+StepExporter &default_step_exporter();
+
+// Write the .step file <relative_path><model_name>.step using the shared exporter
+IFSelect_ReturnStatus
+write_step_file(const std::string &relative_path, const std::string &model_name, const TopoDS_Shape &model_object);
+
+
+#endif //STEP_EXPORTER_H
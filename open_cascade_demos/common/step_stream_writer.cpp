@@ -0,0 +1,270 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Streaming STEP writer with bounded memory
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+
+// Include OpenCascade libraries
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <GProp_GProps.hxx>
+#include <BRepGProp.hxx>
+#include <STEPControl_Reader.hxx>
+
+
+// Include the header of this module
+#include "step_stream_writer.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Number of faces and edges of a shape (used to estimate the size of its STEP translation)
+// ------------------------------------------------------------------------------------------------------------------ //
+static size_t shape_size(const TopoDS_Shape &shape) {
+
+    size_t size = 0;
+    for (TopExp_Explorer explorer(shape, TopAbs_FACE); explorer.More(); explorer.Next()) { size++; }
+    for (TopExp_Explorer explorer(shape, TopAbs_EDGE); explorer.More(); explorer.Next()) { size++; }
+    return max(size, size_t(1));
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Shift the entity numbers (#123) of a line of the DATA section, skipping the content of strings
+// ------------------------------------------------------------------------------------------------------------------ //
+static string renumber_entities(const string &line, size_t offset, bool &in_string, size_t &max_entity) {
+
+    string renumbered;
+    renumbered.reserve(line.size() + 16);
+
+    size_t i = 0;
+    while (i < line.size()) {
+
+        // Strings are delimited by quotes (a quote inside a string is written twice, which toggles the state twice)
+        char c = line[i];
+        if (c == '\'') { in_string = !in_string; }
+
+        // Copy everything except the entity numbers outside strings
+        if (in_string || c != '#' || i + 1 >= line.size() || !isdigit((unsigned char) line[i + 1])) {
+            renumbered += c;
+            i++;
+            continue;
+        }
+
+        // Read the entity number and write it shifted by the offset
+        size_t j = i + 1;
+        size_t entity = 0;
+        while (j < line.size() && isdigit((unsigned char) line[j])) { entity = 10 * entity + (line[j++] - '0'); }
+        max_entity = max(max_entity, entity);
+        renumbered += '#';
+        renumbered += to_string(entity + offset);
+        i = j;
+
+    }
+
+    return renumbered;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Check if a line of the DATA section starts the definition of an entity (#123 = ...)
+// ------------------------------------------------------------------------------------------------------------------ //
+static bool is_entity_definition(const string &line) {
+
+    if (line.empty() || line[0] != '#') { return false; }
+    size_t i = 1;
+    while (i < line.size() && isdigit((unsigned char) line[i])) { i++; }
+    while (i < line.size() && line[i] == ' ') { i++; }
+    return i > 1 && i < line.size() && line[i] == '=';
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Writer that streams the shapes chunk by chunk
+// ------------------------------------------------------------------------------------------------------------------ //
+StepStreamWriter::StepStreamWriter(const string &relative_path, const string &model_name, size_t max_chunk_size,
+                                   STEPControl_StepModelType step_mode)
+        : relative_path_(relative_path), model_name_(model_name), max_chunk_size_(max(max_chunk_size, size_t(1))),
+          step_exporter_(step_mode) {}
+
+
+StepStreamWriter::~StepStreamWriter() {
+
+    if (!closed_) { close(); }
+
+}
+
+
+bool StepStreamWriter::add(const TopoDS_Shape &model_object) {
+
+    if (closed_ || model_object.IsNull()) { return false; }
+    size_t size = shape_size(model_object);
+
+    // Split the compounds that do not fit in a chunk into their children
+    if (size > max_chunk_size_ && model_object.ShapeType() == TopAbs_COMPOUND) {
+        for (TopoDS_Iterator iterator(model_object); iterator.More(); iterator.Next()) {
+            if (!add(iterator.Value())) { return false; }
+        }
+        return true;
+    }
+
+    // Write the pending chunk first if the shape does not fit in it
+    if (pending_size_ > 0 && pending_size_ + size > max_chunk_size_) {
+        if (!write_chunk()) { return false; }
+    }
+
+    // Add the shape to the pending chunk and write the chunk when it is full
+    pending_shapes_.push_back(model_object);
+    pending_size_ += size;
+    if (pending_size_ >= max_chunk_size_) { return write_chunk(); }
+    return true;
+
+}
+
+
+bool StepStreamWriter::close() {
+
+    if (closed_) { return true; }
+    closed_ = true;
+
+    // Write the last chunk
+    bool is_done = write_chunk();
+    if (!header_written_) { return false; }
+
+    // Terminate the DATA section and the file
+    output_ << "ENDSEC;\n" << "END-ISO-10303-21;\n";
+    stats_.number_of_bytes = size_t(output_.tellp());
+    output_.close();
+    return is_done && !output_.fail();
+
+}
+
+
+bool StepStreamWriter::write_chunk() {
+
+    if (pending_shapes_.empty()) { return true; }
+
+    // Translate the pending shapes into a temporary .step file (the exporter starts a new STEP model every time)
+    string chunk_name = model_name_ + ".chunk";
+    IFSelect_ReturnStatus status = step_exporter_.write(relative_path_, chunk_name, pending_shapes_);
+    stats_.largest_chunk_size = max(stats_.largest_chunk_size, pending_size_);
+    pending_shapes_.clear();
+    pending_size_ = 0;
+    if (status != IFSelect_RetDone) { return false; }
+
+    // Move the entities of the chunk to the output file
+    string chunk_file_name = relative_path_ + chunk_name + ".step";
+    bool is_done = append_chunk(chunk_file_name);
+    remove(chunk_file_name.c_str());
+    return is_done;
+
+}
+
+
+bool StepStreamWriter::append_chunk(const string &chunk_file_name) {
+
+    ifstream chunk(chunk_file_name);
+    if (!chunk) { return false; }
+
+    // Open the output file when the first chunk is available
+    if (!header_written_) {
+        output_.open(relative_path_ + model_name_ + ".step", ios::binary);
+        if (!output_) { return false; }
+    }
+
+    string line;
+    bool in_data = false;
+    bool in_string = false;
+    size_t max_entity = 0;
+    while (getline(chunk, line)) {
+
+        // Remove the carriage return of files written with Windows line endings
+        if (!line.empty() && line[line.size() - 1] == '\r') { line.erase(line.size() - 1); }
+
+        // The header of the first chunk (everything up to the DATA keyword) becomes the header of the output
+        if (!in_data) {
+            if (!header_written_) { output_ << line << '\n'; }
+            if (line == "DATA;") { in_data = true; }
+            continue;
+        }
+
+        // Copy the entities of the chunk with shifted numbers
+        if (line == "ENDSEC;") { break; }
+        if (is_entity_definition(line)) { stats_.number_of_entities++; }
+        output_ << renumber_entities(line, entity_offset_, in_string, max_entity) << '\n';
+
+    }
+
+    // The next chunk continues the numbering after the largest entity of this chunk
+    header_written_ = true;
+    entity_offset_ += max_entity;
+    stats_.number_of_chunks++;
+    return in_data && !output_.fail();
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Comparison of two .step files describing the same model
+// ------------------------------------------------------------------------------------------------------------------ //
+StepValidationReport validate_step_files(const string &file_name, const string &reference_file_name,
+                                         double relative_tolerance) {
+
+    StepValidationReport report;
+    const string file_names[2] = {file_name, reference_file_name};
+
+    for (int k = 0; k < 2; ++k) {
+
+        // Read the shape of the file
+        STEPControl_Reader step_reader;
+        if (step_reader.ReadFile(file_names[k].c_str()) != IFSelect_RetDone) { return report; }
+        step_reader.TransferRoots();
+        TopoDS_Shape shape = step_reader.OneShape();
+
+        // Count the distinct faces, edges and vertices
+        TopTools_IndexedMapOfShape faces, edges, vertices;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertices);
+        report.number_of_faces[k] = faces.Extent();
+        report.number_of_edges[k] = edges.Extent();
+        report.number_of_vertices[k] = vertices.Extent();
+
+        // Compute the total area and length
+        GProp_GProps surface_properties, linear_properties;
+        BRepGProp::SurfaceProperties(shape, surface_properties);
+        BRepGProp::LinearProperties(shape, linear_properties);
+        report.area[k] = surface_properties.Mass();
+        report.length[k] = linear_properties.Mass();
+
+    }
+
+    // Compare the two files
+    auto is_close = [relative_tolerance](double a, double b) {
+        return fabs(a - b) <= relative_tolerance * max(max(fabs(a), fabs(b)), 1.0);
+    };
+    report.is_equivalent = report.number_of_faces[0] == report.number_of_faces[1] &&
+                           report.number_of_edges[0] == report.number_of_edges[1] &&
+                           report.number_of_vertices[0] == report.number_of_vertices[1] &&
+                           is_close(report.area[0], report.area[1]) &&
+                           is_close(report.length[0], report.length[1]);
+    return report;
+
+}
@@ -0,0 +1,121 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Streaming STEP writer with bounded memory
+//
+//  STEPControl_Writer translates the whole shape into an in-memory StepData model before writing it, so its peak
+//  memory grows with the size of the model. The StepStreamWriter translates the shapes in chunks of bounded size
+//  instead: each chunk is transferred into a fresh STEP model, serialized, renumbered and appended to the DATA
+//  section of the output file, and then released. Compounds larger than the chunk size are split into their
+//  children, so the peak memory depends on the chunk size and not on the size of the model. A single shape that is
+//  not a compound (for instance one face with thousands of inner wires) cannot be split and becomes one chunk.
+//
+//  Each chunk is written as an independent root (with its own product and representation context), which is valid
+//  STEP and is read back as a compound of the chunks.
+//
+//  Limitation: the chunks are translated independently, so the sub-shapes shared between children that end up in
+//  different chunks (for instance the edges and vertices shared by neighbouring faces of a shell that was split) are
+//  written once per chunk. The merged file is read back with duplicated sub-shapes instead of shared ones: the
+//  geometry is the same, but the topology is no longer connected across the chunk boundaries, and the edge and
+//  vertex counts of validate_step_files differ from those of a single-transfer export. Sharing is kept inside a
+//  chunk and between children that do not share topology, so compounds of disjoint solids or faces (the typical
+//  large assemblies) are not affected. Use write_step_file for models whose connectivity must be preserved.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef STEP_STREAM_WRITER_H
+#define STEP_STREAM_WRITER_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+#include <STEPControl_StepModelType.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of a streamed export
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepStreamStats {
+    int number_of_chunks = 0;               // Number of chunks written to the output file
+    std::size_t number_of_entities = 0;     // Number of STEP entities written to the output file
+    std::size_t largest_chunk_size = 0;     // Largest number of faces and edges translated at once
+    std::size_t number_of_bytes = 0;        // Size of the output file
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Writer that streams the shapes to <relative_path><model_name>.step chunk by chunk
+// ------------------------------------------------------------------------------------------------------------------ //
+class StepStreamWriter {
+
+public:
+
+    // The chunk size is the number of faces and edges that are translated at once
+    StepStreamWriter(const std::string &relative_path, const std::string &model_name,
+                     std::size_t max_chunk_size = 5000,
+                     STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs);
+
+    // Close the output file if close() was not called explicitly
+    ~StepStreamWriter();
+
+    // Add a shape to the output (the pending chunk is written when it becomes full)
+    bool add(const TopoDS_Shape &model_object);
+
+    // Write the pending chunk and terminate the output file
+    bool close();
+
+    // Get the statistics of the export
+    const StepStreamStats &stats() const { return stats_; }
+
+private:
+
+    // Translate the pending shapes and append them to the output file
+    bool write_chunk();
+
+    // Append the DATA section of a chunk file to the output file, shifting the entity numbers
+    bool append_chunk(const std::string &chunk_file_name);
+
+    std::string relative_path_;
+    std::string model_name_;
+    std::size_t max_chunk_size_;
+    StepExporter step_exporter_;
+    std::ofstream output_;
+    bool header_written_ = false;
+    bool closed_ = false;
+    std::size_t entity_offset_ = 0;
+    std::vector<TopoDS_Shape> pending_shapes_;
+    std::size_t pending_size_ = 0;
+    StepStreamStats stats_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Comparison of two .step files describing the same model
+// ------------------------------------------------------------------------------------------------------------------ //
+struct StepValidationReport {
+    bool is_equivalent = false;                 // True if all the checks below passed
+    int number_of_faces[2] = {0, 0};            // Number of faces of each file
+    int number_of_edges[2] = {0, 0};            // Number of edges of each file
+    int number_of_vertices[2] = {0, 0};         // Number of vertices of each file
+    double area[2] = {0.0, 0.0};                // Total area of the faces of each file
+    double length[2] = {0.0, 0.0};              // Total length of the edges of each file
+};
+
+
+// Read both files and compare their topology counts, total area and total length (within a relative tolerance)
+StepValidationReport validate_step_files(const std::string &file_name, const std::string &reference_file_name,
+                                         double relative_tolerance = 1e-9);
+
+
+#endif //STEP_STREAM_WRITER_H
@@ -0,0 +1,206 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Evaluation of B-Spline and NURBS surfaces on dense grids of parameters
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <chrono>
+#include <cmath>
+
+
+// Include the header of this module
+#include "surface_grid_evaluator.h"
+
+
+// Include the shared demo library
+#include "bspline_basis.h"
+#include "bspline_surface_data.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Check whether any of the three arrays of a quantity was requested
+static bool is_requested(double *const quantity[3]) {
+
+    return quantity[0] != nullptr || quantity[1] != nullptr || quantity[2] != nullptr;
+
+}
+
+
+// Store the three coordinates of a quantity in the arrays that were requested
+static void store(double *const quantity[3], size_t index, const double *value) {
+
+    for (int d = 0; d < 3; ++d) {
+        if (quantity[d] != nullptr) { quantity[d][index] = value[d]; }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Spans and basis function derivatives of a list of parameters (derivatives of point i start at (order+1)(p+1) i)
+// ------------------------------------------------------------------------------------------------------------------ //
+static void compute_bases(const vector<double> &knots, int number_of_poles, int degree, int order,
+                          const vector<double> &parameters, double (BSplineSurfaceData::*wrap)(double) const,
+                          const BSplineSurfaceData &data, vector<int> &spans, vector<double> &bases) {
+
+    size_t stride = size_t((order + 1) * (degree + 1));
+    spans.resize(parameters.size());
+    bases.resize(parameters.size() * stride);
+    int span = degree;
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        double t = (data.*wrap)(parameters[i]);
+        span = find_bspline_span(knots.data(), number_of_poles, degree, t, span);
+        spans[i] = span;
+        bspline_basis_derivatives(knots.data(), span, degree, t, order, &bases[i * stride]);
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Evaluate the surface on the grid
+// ------------------------------------------------------------------------------------------------------------------ //
+void evaluate_surface_grid(const Handle(Geom_BSplineSurface) &surface, const vector<double> &u,
+                           const vector<double> &v, const SurfaceGridBuffers &buffers, int number_of_threads,
+                           SurfaceGridStats *stats) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    BSplineSurfaceData data(surface);
+    const int p = data.u_degree;
+    const int q = data.v_degree;
+    const int dimension = data.dimension;
+    const int number_of_v_poles = data.number_of_v_poles;
+    const size_t number_of_u = u.size();
+    const size_t number_of_v = v.size();
+
+    // Highest order of derivation needed by the requested quantities
+    bool need_d1u = is_requested(buffers.d1u), need_d1v = is_requested(buffers.d1v);
+    bool need_d2u = is_requested(buffers.d2u), need_d2uv = is_requested(buffers.d2uv);
+    bool need_d2v = is_requested(buffers.d2v), need_normal = is_requested(buffers.normal);
+    int order = 0;
+    if (need_d1u || need_d1v || need_normal) { order = 1; }
+    if (need_d2u || need_d2uv || need_d2v) { order = 2; }
+
+    // Spans and basis functions of every parameter, computed once per u[i] and once per v[j]
+    vector<int> u_spans, v_spans;
+    vector<double> u_bases, v_bases;
+    compute_bases(data.u_knots, data.number_of_u_poles, p, order, u, &BSplineSurfaceData::wrap_u, data, u_spans,
+                  u_bases);
+    compute_bases(data.v_knots, number_of_v_poles, q, order, v, &BSplineSurfaceData::wrap_v, data, v_spans,
+                  v_bases);
+    chrono::steady_clock::time_point basis_end = chrono::steady_clock::now();
+
+    // Buffer of each worker for the curves of homogeneous points of a row, one array per coordinate like the control
+    // net: rows[(k * dimension + d) * nv + l] is the coordinate d of the derivative of order k in u of the surface at
+    // u[i], with the l-th column of poles in v
+    int threads = resolve_number_of_threads(number_of_threads);
+    size_t row_size = size_t((order + 1) * number_of_v_poles * dimension);
+    vector<vector<double>> per_worker_rows(static_cast<size_t>(threads), vector<double>(row_size));
+
+    const size_t u_stride = size_t((order + 1) * (p + 1));
+    const size_t v_stride = size_t((order + 1) * (q + 1));
+    parallel_for_workers(number_of_u, threads, [&](int worker, size_t i) {
+
+        // ---------------------------------------------------------------------------------------------------------- //
+        // Combine the poles with the basis functions of u[i] (all the columns of poles in v at once), reading the
+        // rows of each coordinate array of the control net as contiguous memory
+        // ---------------------------------------------------------------------------------------------------------- //
+        double *row = per_worker_rows[size_t(worker)].data();
+        const double *Nu = &u_bases[i * u_stride];
+        int first_u_pole = u_spans[i] - p;
+        for (int k = 0; k <= order; ++k) {
+            for (int d = 0; d < dimension; ++d) {
+                double *curve = row + size_t((k * dimension + d) * number_of_v_poles);
+                for (int l = 0; l < number_of_v_poles; ++l) { curve[l] = 0.0; }
+                for (int a = 0; a <= p; ++a) {
+                    double N = Nu[k * (p + 1) + a];
+                    const double *pole_row = data.poles.coordinate(d) + size_t((first_u_pole + a) * number_of_v_poles);
+                    for (int l = 0; l < number_of_v_poles; ++l) { curve[l] += N * pole_row[l]; }
+                }
+            }
+        }
+
+        // ---------------------------------------------------------------------------------------------------------- //
+        // Combine the curves with the basis functions of v[j] at every point of the row
+        // ---------------------------------------------------------------------------------------------------------- //
+        for (size_t j = 0; j < number_of_v; ++j) {
+
+            // Homogeneous derivatives h[ku][kv] of order ku in u and kv in v (ku + kv <= order)
+            const double *Nv = &v_bases[j * v_stride];
+            int first_v_pole = v_spans[j] - q;
+            double h[3][3][4] = {};
+            for (int ku = 0; ku <= order; ++ku) {
+                for (int d = 0; d < dimension; ++d) {
+                    const double *curve = row + size_t((ku * dimension + d) * number_of_v_poles + first_v_pole);
+                    for (int kv = 0; kv <= order - ku; ++kv) {
+                        for (int b = 0; b <= q; ++b) { h[ku][kv][d] += Nv[kv * (q + 1) + b] * curve[b]; }
+                    }
+                }
+            }
+
+            // Quotient rule of the rational surfaces: S = A / w and A^(k,l) = sum of the products of the
+            // derivatives of w and S (the non-rational surfaces keep the polynomial derivatives)
+            double S[3], Su[3], Sv[3], Suu[3], Suv[3], Svv[3];
+            if (dimension == 4) {
+                double w = h[0][0][3];
+                for (int d = 0; d < 3; ++d) {
+                    S[d] = h[0][0][d] / w;
+                    if (order >= 1) {
+                        Su[d] = (h[1][0][d] - h[1][0][3] * S[d]) / w;
+                        Sv[d] = (h[0][1][d] - h[0][1][3] * S[d]) / w;
+                    }
+                    if (order >= 2) {
+                        Suu[d] = (h[2][0][d] - 2.0 * h[1][0][3] * Su[d] - h[2][0][3] * S[d]) / w;
+                        Suv[d] = (h[1][1][d] - h[1][0][3] * Sv[d] - h[0][1][3] * Su[d] - h[1][1][3] * S[d]) / w;
+                        Svv[d] = (h[0][2][d] - 2.0 * h[0][1][3] * Sv[d] - h[0][2][3] * S[d]) / w;
+                    }
+                }
+            } else {
+                for (int d = 0; d < 3; ++d) {
+                    S[d] = h[0][0][d];
+                    Su[d] = h[1][0][d];
+                    Sv[d] = h[0][1][d];
+                    Suu[d] = h[2][0][d];
+                    Suv[d] = h[1][1][d];
+                    Svv[d] = h[0][2][d];
+                }
+            }
+
+            size_t index = i * number_of_v + j;
+            store(buffers.position, index, S);
+            if (need_d1u) { store(buffers.d1u, index, Su); }
+            if (need_d1v) { store(buffers.d1v, index, Sv); }
+            if (need_d2u) { store(buffers.d2u, index, Suu); }
+            if (need_d2uv) { store(buffers.d2uv, index, Suv); }
+            if (need_d2v) { store(buffers.d2v, index, Svv); }
+
+            // Unit normal, left at zero where the first derivatives are (nearly) parallel or vanish
+            if (need_normal) {
+                double n[3] = {Su[1] * Sv[2] - Su[2] * Sv[1], Su[2] * Sv[0] - Su[0] * Sv[2],
+                               Su[0] * Sv[1] - Su[1] * Sv[0]};
+                double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                double scale = sqrt(Su[0] * Su[0] + Su[1] * Su[1] + Su[2] * Su[2]) *
+                               sqrt(Sv[0] * Sv[0] + Sv[1] * Sv[1] + Sv[2] * Sv[2]);
+                for (int d = 0; d < 3; ++d) { n[d] = length > 1e-12 * scale ? n[d] / length : 0.0; }
+                store(buffers.normal, index, n);
+            }
+
+        }
+
+    });
+
+    if (stats != nullptr) {
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        stats->number_of_points = number_of_u * number_of_v;
+        stats->number_of_threads = threads;
+        stats->basis_seconds = chrono::duration<double>(basis_end - start).count();
+        stats->evaluation_seconds = chrono::duration<double>(end - basis_end).count();
+    }
+
+}
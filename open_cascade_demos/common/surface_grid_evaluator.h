@@ -0,0 +1,68 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Evaluation of B-Spline and NURBS surfaces on dense grids of parameters
+//
+//  Curvature analysis and mesh generation sample a surface at every pair (u[i], v[j]) of two sorted arrays of
+//  parameters. Calling Geom_BSplineSurface::D2 at each point locates both knot spans and computes both sets of basis
+//  functions for every point, although they only depend on u[i] or on v[j]. The grid evaluator separates the work:
+//
+//      1. The spans and the basis functions (with their first and second derivatives) are computed once per u[i] and
+//         once per v[j].
+//      2. For each row i, the poles are combined with the u basis functions of u[i] into one curve of homogeneous
+//         points per derivative order in u, for all the v poles at once. The poles are read from the control net of
+//         BSplineSurfaceData (see control_net.h), so each coordinate is a loop over contiguous memory.
+//      3. Each point of the row combines the v basis functions of v[j] with the (q+1) points of these curves that
+//         are non-zero on the span of v[j], which takes 6 (q+1) multiply and add operations per coordinate for the
+//         position and all the derivatives up to the second order.
+//
+//  The rows are split among threads, each with its own buffer for step 2. The results are written to buffers of the
+//  caller, one array per coordinate (structure of arrays), so that they can be passed directly to vectorised code or
+//  written to a file. The point (i, j) is stored at index i * number_of_v_parameters + j of every array.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef SURFACE_GRID_EVALUATOR_H
+#define SURFACE_GRID_EVALUATOR_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Geom_BSplineSurface.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Output arrays of the grid evaluation (x, y and z arrays per quantity, the quantities left null are not computed)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct SurfaceGridBuffers {
+    double *position[3] = {nullptr, nullptr, nullptr};      // S
+    double *d1u[3] = {nullptr, nullptr, nullptr};           // dS/du
+    double *d1v[3] = {nullptr, nullptr, nullptr};           // dS/dv
+    double *d2u[3] = {nullptr, nullptr, nullptr};           // d2S/du2
+    double *d2uv[3] = {nullptr, nullptr, nullptr};          // d2S/dudv
+    double *d2v[3] = {nullptr, nullptr, nullptr};           // d2S/dv2
+    double *normal[3] = {nullptr, nullptr, nullptr};        // Unit normal dS/du x dS/dv (zero where it is undefined)
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Statistics of the grid evaluation
+// ------------------------------------------------------------------------------------------------------------------ //
+struct SurfaceGridStats {
+    std::size_t number_of_points = 0;       // Number of points of the grid
+    int number_of_threads = 0;              // Number of threads used for the rows
+    double basis_seconds = 0.0;             // Wall-clock time spent computing the basis functions of the parameters
+    double evaluation_seconds = 0.0;        // Wall-clock time spent evaluating the rows
+};
+
+
+// Evaluate the surface at every pair (u[i], v[j]) and write the requested quantities to the buffers
+void evaluate_surface_grid(const Handle(Geom_BSplineSurface) &surface, const std::vector<double> &u,
+                           const std::vector<double> &v, const SurfaceGridBuffers &buffers,
+                           int number_of_threads = 0, SurfaceGridStats *stats = nullptr);
+
+
+#endif //SURFACE_GRID_EVALUATOR_H
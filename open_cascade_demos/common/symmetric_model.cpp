@@ -0,0 +1,142 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Models generated from a seed shape by a group of rotations and mirrors
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cmath>
+
+
+// Include OpenCascade libraries
+#include <gp_Dir.hxx>
+#include <gp_Vec.hxx>
+#include <Precision.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+
+
+// Include the header of this module
+#include "symmetric_model.h"
+
+
+// Include the shared demo library
+#include "located_transform.h"
+#include "parallel_build.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Symmetry group
+// ------------------------------------------------------------------------------------------------------------------ //
+SymmetryGroup::SymmetryGroup(const gp_Ax1 &axis, int number_of_sectors) :
+        axis_(axis), number_of_sectors_(max(1, number_of_sectors)) {}
+
+
+bool SymmetryGroup::add_mirror_plane(const gp_Ax2 &plane) {
+
+    // The group stays closed only if the plane contains the axis (the mirror reverses the angle of the rotations) or
+    // is perpendicular to it (the mirror commutes with the rotations)
+    const gp_Dir &normal = plane.Direction();
+    double distance = gp_Vec(plane.Location(), axis_.Location()).Dot(gp_Vec(normal));
+    bool contains_axis = normal.IsNormal(axis_.Direction(), Precision::Angular()) &&
+                         fabs(distance) <= Precision::Confusion();
+    bool is_perpendicular = normal.IsParallel(axis_.Direction(), Precision::Angular());
+
+    if (contains_axis && !has_axial_mirror_) {
+        axial_mirror_.SetMirror(plane);
+        has_axial_mirror_ = true;
+        return true;
+    }
+    if (is_perpendicular && !has_transverse_mirror_) {
+        transverse_mirror_.SetMirror(plane);
+        has_transverse_mirror_ = true;
+        return true;
+    }
+    return false;
+
+}
+
+
+size_t SymmetryGroup::order() const {
+
+    size_t number_of_mirror_combinations = size_t(1) << (int(has_axial_mirror_) + int(has_transverse_mirror_));
+    return size_t(number_of_sectors_) * number_of_mirror_combinations;
+
+}
+
+
+gp_Trsf SymmetryGroup::rotation(size_t i) const {
+
+    gp_Trsf rotation;
+    size_t sector = i % size_t(number_of_sectors_);
+    if (sector != 0) { rotation.SetRotation(axis_, 2.0 * M_PI * double(sector) / number_of_sectors_); }
+    return rotation;
+
+}
+
+
+gp_Trsf SymmetryGroup::mirror(size_t i) const {
+
+    // The bits of the mirror index select the mirrors that the group contains, in the order axial, transverse
+    int bits = mirror_index(i);
+    gp_Trsf mirror;
+    if (has_axial_mirror_) {
+        if (bits & 1) { mirror.Multiply(axial_mirror_); }
+        bits >>= 1;
+    }
+    if (has_transverse_mirror_ && (bits & 1)) { mirror.Multiply(transverse_mirror_); }
+    return mirror;
+
+}
+
+
+gp_Trsf SymmetryGroup::transformation(size_t i) const {
+
+    return rotation(i).Multiplied(mirror(i));
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Symmetric model
+// ------------------------------------------------------------------------------------------------------------------ //
+SymmetricModel::SymmetricModel(const TopoDS_Shape &seed, const SymmetryGroup &group) : seed_(seed), group_(group) {}
+
+
+const TopoDS_Shape &SymmetricModel::mirrored_seed(int mirror_index) const {
+
+    // The seed itself needs no mirror, the other combinations are built once by the first thread that needs them
+    if (mirror_index == 0) { return seed_; }
+    call_once(mirrored_seed_flags_[mirror_index], [this, mirror_index]() {
+        gp_Trsf mirror = group_.mirror(size_t(mirror_index) * size_t(group_.number_of_sectors()));
+        mirrored_seeds_[mirror_index] = located_transform(seed_, mirror);
+    });
+    return mirrored_seeds_[mirror_index];
+
+}
+
+
+TopoDS_Shape SymmetricModel::instance(size_t i) const {
+
+    // The rotations are applied as locations on top of the (possibly copied) mirror image of the seed
+    return located_transform(mirrored_seed(group_.mirror_index(i)), group_.rotation(i));
+
+}
+
+
+TopoDS_Compound SymmetricModel::materialise(int number_of_threads, bool copy_geometry) const {
+
+    return parallel_build_compound(size(), number_of_threads, [&](size_t i) -> TopoDS_Shape {
+        if (copy_geometry) {
+            BRepBuilderAPI_Transform copy(seed_, group_.transformation(i), Standard_True);
+            return copy.Shape();
+        }
+        return instance(i);
+    });
+
+}
@@ -0,0 +1,126 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  Models generated from a seed shape by a group of rotations and mirrors
+//
+//  A row of turbomachinery blades, a bladed disk or the cylinder of demo_bezier_surface_rational are made of copies
+//  of a seed shape (one sector) transformed by the elements of a symmetry group:
+//
+//      cyclic group        N rotations by multiples of 360/N degrees about an axis
+//      dihedral group      the N rotations and the N rotations composed with a mirror in a plane containing the axis
+//      transverse mirror   a mirror in a plane perpendicular to the axis, which doubles the group again
+//
+//  The element number i of a group with N sectors is rotation(i % N) * mirrors(i / N), where the bits of i / N select
+//  the mirror in the plane containing the axis (bit 0) and the mirror in the plane perpendicular to it (bit 1). Both
+//  mirrors map the axis onto itself, so the group is closed under them: the transverse mirror commutes with the
+//  rotations, and the axial mirror reverses their angle (mirror * rotation(k) = rotation(-k) * mirror) instead of
+//  commuting with them. Any product of rotations and mirrors is therefore equal to one rotation(k) * mirrors(m), and
+//  listing these products for every k and m gives each element of the group exactly once, which is why the elements
+//  can be computed directly from their index.
+//
+//  SymmetricModel stores the seed and the group only, so creating a model takes the same time whatever the number of
+//  sectors. The instances are built on request as located shapes (see located_transform.h): each combination of
+//  mirrors is applied once to the seed (copying its geometry if the version of OpenCascade requires it) and the
+//  rotations are applied as locations, so all the instances share at most four copies of the geometry. A compound of
+//  all the instances can be materialised in parallel, either with located instances or with copies of the geometry.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef SYMMETRIC_MODEL_H
+#define SYMMETRIC_MODEL_H
+
+
+// Include standard C++ libraries
+#include <cstddef>
+#include <mutex>
+
+
+// Include OpenCascade libraries
+#include <gp_Ax1.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Trsf.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Shape.hxx>
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Group of rotations about an axis, optionally extended by mirrors
+// ------------------------------------------------------------------------------------------------------------------ //
+class SymmetryGroup {
+
+public:
+
+    // Cyclic group of the rotations by multiples of 360/number_of_sectors degrees about the axis
+    explicit SymmetryGroup(const gp_Ax1 &axis, int number_of_sectors = 1);
+
+    // Add a mirror in a plane (the plane through the location of the axes, normal to their main direction)
+    // The plane must contain the axis of rotation or be perpendicular to it, and each kind of mirror can only be added
+    // once. Returns false (leaving the group unchanged) otherwise
+    bool add_mirror_plane(const gp_Ax2 &plane);
+
+    const gp_Ax1 &axis() const { return axis_; }
+    int number_of_sectors() const { return number_of_sectors_; }
+    bool has_axial_mirror() const { return has_axial_mirror_; }
+    bool has_transverse_mirror() const { return has_transverse_mirror_; }
+
+    // Number of elements of the group
+    std::size_t order() const;
+
+    // Element number i of the group, with 0 <= i < order() (the element 0 is the identity)
+    gp_Trsf transformation(std::size_t i) const;
+
+    // Rotation part and mirror part of the element number i (transformation(i) = rotation(i) * mirror(i))
+    gp_Trsf rotation(std::size_t i) const;
+    gp_Trsf mirror(std::size_t i) const;
+    int mirror_index(std::size_t i) const { return int(i / std::size_t(number_of_sectors_)); }
+
+private:
+
+    gp_Ax1 axis_;
+    int number_of_sectors_;
+    bool has_axial_mirror_ = false;
+    bool has_transverse_mirror_ = false;
+    gp_Trsf axial_mirror_;
+    gp_Trsf transverse_mirror_;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Seed shape and the instances generated by a symmetry group
+// ------------------------------------------------------------------------------------------------------------------ //
+class SymmetricModel {
+
+public:
+
+    // Store the seed and the group (no shape is built here)
+    SymmetricModel(const TopoDS_Shape &seed, const SymmetryGroup &group);
+
+    SymmetricModel(const SymmetricModel &) = delete;
+    SymmetricModel &operator=(const SymmetricModel &) = delete;
+
+    const TopoDS_Shape &seed() const { return seed_; }
+    const SymmetryGroup &group() const { return group_; }
+    std::size_t size() const { return group_.order(); }
+
+    // Instance number i, sharing the geometry of the seed (or of its mirror image) through its location
+    // The instances can be requested from several threads at the same time
+    TopoDS_Shape instance(std::size_t i) const;
+
+    // Compound of all the instances in index order, built in parallel (the located instances by default, or copies
+    // of the geometry made by BRepBuilderAPI_Transform)
+    TopoDS_Compound materialise(int number_of_threads = 0, bool copy_geometry = false) const;
+
+private:
+
+    // Seed transformed by the mirrors of the mirror index (built on the first request)
+    const TopoDS_Shape &mirrored_seed(int mirror_index) const;
+
+    TopoDS_Shape seed_;
+    SymmetryGroup group_;
+    mutable std::once_flag mirrored_seed_flags_[4];
+    mutable TopoDS_Shape mirrored_seeds_[4];
+
+};
+
+
+#endif //SYMMETRIC_MODEL_H
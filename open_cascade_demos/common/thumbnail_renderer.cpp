@@ -0,0 +1,420 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  CPU software rasterizer for PNG thumbnails of the models
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+
+// Include standard C++ libraries
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+
+// Include OpenCascade libraries
+#include <Standard_Version.hxx>
+#include <gp_XYZ.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Poly_Triangulation.hxx>
+
+
+// Include the header of this module
+#include "thumbnail_renderer.h"
+#include "parallel_for.h"
+
+
+// Define namespaces
+using namespace std;
+
+
+// Colors of the background, the faces (before shading) and the edges
+static const unsigned char BACKGROUND_COLOR[3] = {255, 255, 255};
+static const float FACE_COLOR[3] = {170.0f, 192.0f, 220.0f};
+static const float EDGE_COLOR[3] = {25.0f, 35.0f, 50.0f};
+
+// Half of the width of the edges in pixels
+static const float EDGE_HALF_WIDTH = 0.6f;
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Primitives projected to the image (x to the right and y downwards in pixels, larger depth is closer to the viewer)
+// ------------------------------------------------------------------------------------------------------------------ //
+struct ScreenTriangle {
+    float x[3], y[3], depth[3];
+    unsigned char color[3];
+};
+
+
+struct ScreenSegment {
+    float x[2], y[2], depth[2];
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Orthographic camera fitting the model in the image
+// ------------------------------------------------------------------------------------------------------------------ //
+class Camera {
+
+public:
+
+    // Orient the camera (the view direction points from the model to the viewer)
+    Camera(const gp_XYZ &view_direction) {
+        view_ = view_direction.Normalized();
+        gp_XYZ up_hint = fabs(view_.Z()) > 0.99 ? gp_XYZ(0.0, 1.0, 0.0) : gp_XYZ(0.0, 0.0, 1.0);
+        right_ = up_hint.Crossed(view_).Normalized();
+        up_ = view_.Crossed(right_);
+    }
+
+    // Extend the region that must fit in the image
+    void add(const gp_XYZ &point) {
+        double u = point.Dot(right_), v = point.Dot(up_), d = point.Dot(view_);
+        u_min_ = min(u_min_, u); u_max_ = max(u_max_, u);
+        v_min_ = min(v_min_, v); v_max_ = max(v_max_, v);
+        depth_min_ = min(depth_min_, d); depth_max_ = max(depth_max_, d);
+    }
+
+    // Compute the scale that fits the region in the image with a small margin
+    void fit(int width, int height) {
+        double margin = 0.05 * min(width, height);
+        double u_extent = u_max_ - u_min_, v_extent = v_max_ - v_min_;
+        double scale_u = u_extent > 0.0 ? (width - 2.0 * margin) / u_extent : DBL_MAX;
+        double scale_v = v_extent > 0.0 ? (height - 2.0 * margin) / v_extent : DBL_MAX;
+        scale_ = min(scale_u, scale_v);
+        if (scale_ == DBL_MAX) { scale_ = 1.0; }
+        u_center_ = 0.5 * (u_min_ + u_max_);
+        v_center_ = 0.5 * (v_min_ + v_max_);
+        x_center_ = 0.5 * width;
+        y_center_ = 0.5 * height;
+    }
+
+    // Project a point to the image
+    void project(const gp_XYZ &point, float &x, float &y, float &depth) const {
+        x = float(x_center_ + scale_ * (point.Dot(right_) - u_center_));
+        y = float(y_center_ - scale_ * (point.Dot(up_) - v_center_));
+        depth = float(point.Dot(view_));
+    }
+
+    const gp_XYZ &view() const { return view_; }
+    const gp_XYZ &up() const { return up_; }
+    const gp_XYZ &right() const { return right_; }
+    double depth_range() const { return depth_max_ > depth_min_ ? depth_max_ - depth_min_ : 0.0; }
+
+private:
+
+    gp_XYZ view_, right_, up_;
+    double u_min_ = DBL_MAX, u_max_ = -DBL_MAX, v_min_ = DBL_MAX, v_max_ = -DBL_MAX;
+    double depth_min_ = DBL_MAX, depth_max_ = -DBL_MAX;
+    double scale_ = 1.0, u_center_ = 0.0, v_center_ = 0.0, x_center_ = 0.0, y_center_ = 0.0;
+
+};
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Default view direction: look at flat models from the front and at the others from an isometric point of view
+// ------------------------------------------------------------------------------------------------------------------ //
+static gp_XYZ automatic_view_direction(const double extents[3], double diagonal) {
+
+    int flat_axis = -1, number_of_flat_axes = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (extents[k] <= 1e-6 * diagonal) {
+            flat_axis = k;
+            number_of_flat_axes++;
+        }
+    }
+    if (number_of_flat_axes != 1) { return gp_XYZ(1.0, -1.0, 1.0); }
+    if (flat_axis == 0) { return gp_XYZ(1.0, 0.0, 0.0); }
+    if (flat_axis == 1) { return gp_XYZ(0.0, -1.0, 0.0); }
+    return gp_XYZ(0.0, 0.0, 1.0);
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Rasterization of the primitives that overlap a tile
+// ------------------------------------------------------------------------------------------------------------------ //
+
+// Signed area of the parallelogram (a, b, p), positive if p is on the left of a->b in a y-up frame
+static inline float edge_function(float ax, float ay, float bx, float by, float px, float py) {
+
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+
+}
+
+
+// Pixel bounds of a tile: [x_begin, x_end) x [y_begin, y_end)
+struct Tile {
+    int x_begin, y_begin, x_end, y_end;
+    int width() const { return x_end - x_begin; }
+};
+
+
+// Fill the pixels of the tile covered by the triangle that are closer than the content of the depth buffer
+static void rasterize_triangle(const ScreenTriangle &triangle, const Tile &tile, vector<float> &depth_buffer,
+                               RgbImage &image) {
+
+    const float *x = triangle.x, *y = triangle.y;
+    float area = edge_function(x[0], y[0], x[1], y[1], x[2], y[2]);
+    if (fabs(area) < 1e-12f) { return; }
+
+    // Visit the pixels of the bounding box of the triangle that are inside the tile
+    int px_begin = max(tile.x_begin, int(floor(min(x[0], min(x[1], x[2])))));
+    int px_end = min(tile.x_end, int(ceil(max(x[0], max(x[1], x[2])))) + 1);
+    int py_begin = max(tile.y_begin, int(floor(min(y[0], min(y[1], y[2])))));
+    int py_end = min(tile.y_end, int(ceil(max(y[0], max(y[1], y[2])))) + 1);
+
+    for (int py = py_begin; py < py_end; ++py) {
+        for (int px = px_begin; px < px_end; ++px) {
+
+            // Barycentric coordinates of the center of the pixel
+            float cx = px + 0.5f, cy = py + 0.5f;
+            float b0 = edge_function(x[1], y[1], x[2], y[2], cx, cy) / area;
+            float b1 = edge_function(x[2], y[2], x[0], y[0], cx, cy) / area;
+            float b2 = 1.0f - b0 - b1;
+            if (b0 < 0.0f || b1 < 0.0f || b2 < 0.0f) { continue; }
+
+            // Depth test
+            float depth = b0 * triangle.depth[0] + b1 * triangle.depth[1] + b2 * triangle.depth[2];
+            float &stored_depth = depth_buffer[(py - tile.y_begin) * tile.width() + (px - tile.x_begin)];
+            if (depth <= stored_depth) { continue; }
+            stored_depth = depth;
+
+            unsigned char *pixel = image.pixel(px, py);
+            pixel[0] = triangle.color[0];
+            pixel[1] = triangle.color[1];
+            pixel[2] = triangle.color[2];
+
+        }
+    }
+
+}
+
+
+// Accumulate the coverage of the visible pixels of the tile that are close to the segment
+static void rasterize_segment(const ScreenSegment &segment, const Tile &tile, const vector<float> &depth_buffer,
+                              float depth_bias, vector<float> &coverage_buffer) {
+
+    const float *x = segment.x, *y = segment.y;
+    float dx = x[1] - x[0], dy = y[1] - y[0];
+    float squared_length = dx * dx + dy * dy;
+
+    // Visit the pixels of the bounding box of the thick segment that are inside the tile
+    float reach = EDGE_HALF_WIDTH + 1.0f;
+    int px_begin = max(tile.x_begin, int(floor(min(x[0], x[1]) - reach)));
+    int px_end = min(tile.x_end, int(ceil(max(x[0], x[1]) + reach)) + 1);
+    int py_begin = max(tile.y_begin, int(floor(min(y[0], y[1]) - reach)));
+    int py_end = min(tile.y_end, int(ceil(max(y[0], y[1]) + reach)) + 1);
+
+    for (int py = py_begin; py < py_end; ++py) {
+        for (int px = px_begin; px < px_end; ++px) {
+
+            // Distance from the center of the pixel to the segment
+            float cx = px + 0.5f, cy = py + 0.5f;
+            float t = squared_length > 0.0f ? ((cx - x[0]) * dx + (cy - y[0]) * dy) / squared_length : 0.0f;
+            t = min(max(t, 0.0f), 1.0f);
+            float distance = hypot(cx - (x[0] + t * dx), cy - (y[0] + t * dy));
+            float coverage = min(EDGE_HALF_WIDTH + 0.5f - distance, 1.0f);
+            if (coverage <= 0.0f) { continue; }
+
+            // The edges lie on the faces, so they are compared with the depth buffer with some tolerance
+            size_t index = size_t(py - tile.y_begin) * tile.width() + (px - tile.x_begin);
+            float depth = segment.depth[0] + t * (segment.depth[1] - segment.depth[0]);
+            if (depth + depth_bias < depth_buffer[index]) { continue; }
+            coverage_buffer[index] = max(coverage_buffer[index], coverage);
+
+        }
+    }
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Render the shape into an RGB image
+// ------------------------------------------------------------------------------------------------------------------ //
+RgbImage render_thumbnail(const TopoDS_Shape &model_object, const ThumbnailOptions &options) {
+
+    RgbImage image(max(options.width, 1), max(options.height, 1));
+    for (size_t i = 0; i < image.pixels.size(); i += 3) {
+        image.pixels[i] = BACKGROUND_COLOR[0];
+        image.pixels[i + 1] = BACKGROUND_COLOR[1];
+        image.pixels[i + 2] = BACKGROUND_COLOR[2];
+    }
+    if (model_object.IsNull()) { return image; }
+
+    // Get the size of the model
+    Bnd_Box bounding_box;
+    BRepBndLib::Add(model_object, bounding_box);
+    if (bounding_box.IsVoid()) { return image; }
+    double x_min, y_min, z_min, x_max, y_max, z_max;
+    bounding_box.Get(x_min, y_min, z_min, x_max, y_max, z_max);
+    double extents[3] = {x_max - x_min, y_max - y_min, z_max - z_min};
+    double diagonal = sqrt(extents[0] * extents[0] + extents[1] * extents[1] + extents[2] * extents[2]);
+    if (diagonal <= 0.0) { diagonal = 1.0; }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Tessellate the faces and discretize the edges
+    // -------------------------------------------------------------------------------------------------------------- //
+
+    // The triangulation is stored in the faces (it is only recomputed if the existing one is too coarse)
+    double deflection = options.relative_deflection * diagonal;
+    bool is_parallel = resolve_number_of_threads(options.number_of_threads) > 1;
+    BRepMesh_IncrementalMesh mesher(model_object, deflection, Standard_False, options.angular_deflection, is_parallel);
+
+    // Collect the triangles of all the faces (three corners per triangle)
+    vector<gp_XYZ> corners;
+    TopTools_IndexedMapOfShape faces;
+    if (options.draw_faces) { TopExp::MapShapes(model_object, TopAbs_FACE, faces); }
+    for (int i = 1; i <= faces.Extent(); ++i) {
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(TopoDS::Face(faces(i)), location);
+        if (triangulation.IsNull()) { continue; }
+        const gp_Trsf &transformation = location.Transformation();
+        for (int k = 1; k <= triangulation->NbTriangles(); ++k) {
+            int nodes[3];
+#if OCC_VERSION_HEX >= 0x070600
+            triangulation->Triangle(k).Get(nodes[0], nodes[1], nodes[2]);
+            for (int n : nodes) { corners.push_back(triangulation->Node(n).Transformed(transformation).XYZ()); }
+#else
+            triangulation->Triangles().Value(k).Get(nodes[0], nodes[1], nodes[2]);
+            for (int n : nodes) {
+                corners.push_back(triangulation->Nodes().Value(n).Transformed(transformation).XYZ());
+            }
+#endif
+        }
+    }
+
+    // Discretize the edges in parallel (each edge writes its own polyline)
+    TopTools_IndexedMapOfShape edges;
+    if (options.draw_edges) { TopExp::MapShapes(model_object, TopAbs_EDGE, edges); }
+    vector<vector<gp_XYZ>> polylines(edges.Extent());
+    parallel_for(polylines.size(), options.number_of_threads, [&](size_t i) {
+        const TopoDS_Edge &edge = TopoDS::Edge(edges(int(i) + 1));
+        if (BRep_Tool::Degenerated(edge)) { return; }
+        BRepAdaptor_Curve curve(edge);
+        GCPnts_TangentialDeflection discretizer(curve, options.angular_deflection, deflection);
+        for (int k = 1; k <= discretizer.NbPoints(); ++k) { polylines[i].push_back(discretizer.Value(k).XYZ()); }
+    });
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Project the primitives to the image
+    // -------------------------------------------------------------------------------------------------------------- //
+    gp_XYZ view_direction(options.view_direction[0], options.view_direction[1], options.view_direction[2]);
+    if (view_direction.Modulus() == 0.0) { view_direction = automatic_view_direction(extents, diagonal); }
+    Camera camera(view_direction);
+    for (const gp_XYZ &corner : corners) { camera.add(corner); }
+    for (const vector<gp_XYZ> &polyline : polylines) { for (const gp_XYZ &point : polyline) { camera.add(point); } }
+    camera.fit(image.width, image.height);
+
+    // Flat shading with a light slightly above and on the right of the viewer (both sides of the faces are lit)
+    gp_XYZ light = (camera.view() + 0.4 * camera.up() + 0.2 * camera.right()).Normalized();
+    vector<ScreenTriangle> triangles(corners.size() / 3);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        ScreenTriangle &triangle = triangles[i];
+        for (int k = 0; k < 3; ++k) {
+            camera.project(corners[3 * i + k], triangle.x[k], triangle.y[k], triangle.depth[k]);
+        }
+        gp_XYZ normal = (corners[3 * i + 1] - corners[3 * i]).Crossed(corners[3 * i + 2] - corners[3 * i]);
+        double length = normal.Modulus();
+        double intensity = 0.35 + 0.65 * (length > 0.0 ? fabs(normal.Dot(light)) / length : 1.0);
+        for (int c = 0; c < 3; ++c) { triangle.color[c] = (unsigned char) lround(FACE_COLOR[c] * intensity); }
+    }
+
+    vector<ScreenSegment> segments;
+    for (const vector<gp_XYZ> &polyline : polylines) {
+        for (size_t k = 1; k < polyline.size(); ++k) {
+            ScreenSegment segment;
+            camera.project(polyline[k - 1], segment.x[0], segment.y[0], segment.depth[0]);
+            camera.project(polyline[k], segment.x[1], segment.y[1], segment.depth[1]);
+            segments.push_back(segment);
+        }
+    }
+
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Sort the primitives into tiles and rasterize the tiles in parallel
+    // -------------------------------------------------------------------------------------------------------------- //
+    int tile_size = max(options.tile_size, 8);
+    int tiles_x = (image.width + tile_size - 1) / tile_size;
+    int tiles_y = (image.height + tile_size - 1) / tile_size;
+    vector<vector<int>> tile_triangles(tiles_x * tiles_y), tile_segments(tiles_x * tiles_y);
+
+    // Add the index of a primitive to all the tiles overlapped by its bounding box
+    auto bin = [&](vector<vector<int>> &bins, int index, float x_lo, float y_lo, float x_hi, float y_hi) {
+        int i_begin = max(int(floor(x_lo)) / tile_size, 0), i_end = min(int(floor(x_hi)) / tile_size, tiles_x - 1);
+        int j_begin = max(int(floor(y_lo)) / tile_size, 0), j_end = min(int(floor(y_hi)) / tile_size, tiles_y - 1);
+        for (int j = j_begin; j <= j_end; ++j) {
+            for (int i = i_begin; i <= i_end; ++i) { bins[j * tiles_x + i].push_back(index); }
+        }
+    };
+    for (size_t k = 0; k < triangles.size(); ++k) {
+        const ScreenTriangle &t = triangles[k];
+        bin(tile_triangles, int(k), min(t.x[0], min(t.x[1], t.x[2])), min(t.y[0], min(t.y[1], t.y[2])),
+            max(t.x[0], max(t.x[1], t.x[2])), max(t.y[0], max(t.y[1], t.y[2])));
+    }
+    float reach = EDGE_HALF_WIDTH + 1.0f;
+    for (size_t k = 0; k < segments.size(); ++k) {
+        const ScreenSegment &s = segments[k];
+        bin(tile_segments, int(k), min(s.x[0], s.x[1]) - reach, min(s.y[0], s.y[1]) - reach,
+            max(s.x[0], s.x[1]) + reach, max(s.y[0], s.y[1]) + reach);
+    }
+
+    // Each tile owns its pixels, so the threads never write to the same part of the image
+    float depth_bias = float(0.01 * camera.depth_range() + 1e-6 * diagonal);
+    parallel_for(tile_triangles.size(), options.number_of_threads, [&](size_t index) {
+
+        int i = int(index) % tiles_x, j = int(index) / tiles_x;
+        Tile tile = {i * tile_size, j * tile_size, min((i + 1) * tile_size, image.width),
+                     min((j + 1) * tile_size, image.height)};
+        size_t number_of_pixels = size_t(tile.width()) * (tile.y_end - tile.y_begin);
+
+        // Draw the faces
+        vector<float> depth_buffer(number_of_pixels, -FLT_MAX);
+        for (int k : tile_triangles[index]) { rasterize_triangle(triangles[k], tile, depth_buffer, image); }
+
+        // Draw the edges on top of the faces
+        if (tile_segments[index].empty()) { return; }
+        vector<float> coverage_buffer(number_of_pixels, 0.0f);
+        for (int k : tile_segments[index]) {
+            rasterize_segment(segments[k], tile, depth_buffer, depth_bias, coverage_buffer);
+        }
+        for (int py = tile.y_begin; py < tile.y_end; ++py) {
+            for (int px = tile.x_begin; px < tile.x_end; ++px) {
+                float coverage = coverage_buffer[(py - tile.y_begin) * tile.width() + (px - tile.x_begin)];
+                if (coverage <= 0.0f) { continue; }
+                unsigned char *pixel = image.pixel(px, py);
+                for (int c = 0; c < 3; ++c) {
+                    pixel[c] = (unsigned char) lround(pixel[c] * (1.0f - coverage) + EDGE_COLOR[c] * coverage);
+                }
+            }
+        }
+
+    });
+
+    return image;
+
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Render the shape and write the image to a PNG file
+// ------------------------------------------------------------------------------------------------------------------ //
+bool write_thumbnail(const string &file_name, const TopoDS_Shape &model_object, const ThumbnailOptions &options) {
+
+    return write_png_file(file_name, render_thumbnail(model_object, options));
+
+}
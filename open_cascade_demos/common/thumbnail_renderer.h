@@ -0,0 +1,56 @@
+// ------------------------------------------------------------------------------------------------------------------- //
+//
+//  CPU software rasterizer for PNG thumbnails of the models
+//
+//  The model is tessellated with BRepMesh (the triangulation is stored in the faces of the shape, so a second
+//  thumbnail of the same shape does not tessellate it again) and the edges are discretized with a tangential
+//  deflection criterion. The triangles and the edge segments are projected with an orthographic camera that fits the
+//  model in the image, sorted into square tiles, and the tiles are rasterized in parallel, each one with its own depth
+//  buffer. The faces are flat-shaded and the edges are drawn on top of them, hidden by the faces in front of them.
+//  Everything runs on the CPU, so no GPU and no display server are needed.
+//
+//  Models without faces (for instance a single curve) are drawn as edges only.
+//
+// ------------------------------------------------------------------------------------------------------------------ //
+
+#ifndef THUMBNAIL_RENDERER_H
+#define THUMBNAIL_RENDERER_H
+
+
+// Include standard C++ libraries
+#include <string>
+
+
+// Include OpenCascade libraries
+#include <TopoDS_Shape.hxx>
+
+
+// Include the shared demo library
+#include "png_writer.h"
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Options of the thumbnail renderer
+// ------------------------------------------------------------------------------------------------------------------ //
+struct ThumbnailOptions {
+    int width = 512;                                // Width of the image in pixels
+    int height = 512;                               // Height of the image in pixels
+    int tile_size = 32;                             // Size of the square tiles rasterized by each thread
+    int number_of_threads = 0;                      // Number of threads (zero means one per hardware core)
+    double relative_deflection = 0.002;             // Tessellation deflection relative to the bounding box diagonal
+    double angular_deflection = 0.3;                // Tessellation angular deflection (radians)
+    double view_direction[3] = {0.0, 0.0, 0.0};     // Direction towards the viewer (zero means automatic)
+    bool draw_faces = true;                         // Draw the shaded faces
+    bool draw_edges = true;                         // Draw the edges (hidden by the faces in front of them)
+};
+
+
+// Render the shape into an RGB image (an empty model gives a blank image)
+RgbImage render_thumbnail(const TopoDS_Shape &model_object, const ThumbnailOptions &options = ThumbnailOptions());
+
+// Render the shape and write the image to a PNG file
+bool write_thumbnail(const std::string &file_name, const TopoDS_Shape &model_object,
+                     const ThumbnailOptions &options = ThumbnailOptions());
+
+
+#endif //THUMBNAIL_RENDERER_H
@@ -8,7 +8,6 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <sys/stat.h>
 #include <cmath>
 
 
@@ -22,7 +21,13 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
-#include <STEPControl_Writer.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+#include "run_options.h"
+#include "model_hash.h"
+#include "export_cache.h"
 
 
 // Define namespaces
@@ -30,28 +35,24 @@ using namespace std;
 
 
 // ------------------------------------------------------------------------------------------------------------------ //
-// Step file exporter
+// Define the geometry and topology of a Bezier surface
 // ------------------------------------------------------------------------------------------------------------------ //
-IFSelect_ReturnStatus
-write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
-
-    // Create the .step writer object
-    STEPControl_Writer step_writer;
+TopoDS_Shape make_bezier_surface(const TColgp_Array2OfPnt &P) {
 
-    // Set the type of .step representation
-    STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs;
+    // Define the geometry of a Bezier surface referenced by handle
+    Handle(Geom_BezierSurface) BezierGeo = new Geom_BezierSurface(P);
 
-    // Create the output directory if it does not exist
-    mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
+    // Define the topology of the Bezier surface using the BRepBuilderAPI
+    TopoDS_Face BezierFace = BRepBuilderAPI_MakeFace(BezierGeo, 0);
 
-    // Get the full path to the step file as a C-string
-    string temp = (relative_path + model_name + ".step");
-    Standard_CString file_name = temp.c_str();
+    // Get the geometric surface from the topological face and check the bounds in parametric space [Optional]
+    Handle(Geom_Surface) BezierGeo_bis = BRep_Tool::Surface (BezierFace);
+    double u_lower, u_upper, v_lower, v_upper;
+    BezierGeo_bis->Bounds(u_lower, u_upper, v_lower, v_upper);
 
-    // Write the .step file
-    step_writer.Transfer(model_object, step_mode);
-    IFSelect_ReturnStatus status = step_writer.Write(file_name);
-    return status;
+    // Create a TopoDS_Shape object to export as .step
+    TopoDS_Shape open_cascade_model = BezierFace;
+    return open_cascade_model;
 
 }
 
@@ -59,7 +60,12 @@ write_step_file(const string &relative_path, const string &model_name, const Top
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_bezier_surface", run_options.timings);
+    stage_timer.start("model");
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Define the array of control points
@@ -93,41 +99,43 @@ int main() {
 
 
     // -------------------------------------------------------------------------------------------------------------- //
-    // Define the geometry and topology of a Bezier surface
-    // -------------------------------------------------------------------------------------------------------------- //
-
-    // Define the geometry of a Bezier surface referenced by handle
-    Handle(Geom_BezierSurface) BezierGeo = new Geom_BezierSurface(P);
-
-    // Define the topology of the Bezier surface using the BRepBuilderAPI
-    TopoDS_Face BezierFace = BRepBuilderAPI_MakeFace(BezierGeo, 0);
-
-    // Get the geometric surface from the topological face and check the bounds in parametric space [Optional]
-    Handle(Geom_Surface) BezierGeo_bis = BRep_Tool::Surface (BezierFace);
-    double u_lower, u_upper, v_lower, v_upper;
-    BezierGeo_bis->Bounds(u_lower, u_upper, v_lower, v_upper);
-
-
-    // -------------------------------------------------------------------------------------------------------------- //
-    // Export the model as a STEP file
+    // Export the model as a STEP file (unless it was already exported from the same control points)
     // -------------------------------------------------------------------------------------------------------------- //
 
-    // Create a TopoDS_Shape object to export as .step
-    TopoDS_Shape open_cascade_model = BezierFace;
+    // Start timing the export
+    stage_timer.start("export");
 
     // Set the destination path and the name of the .step file
     string relative_path = "../output/";
     string file_name = "bezier_surface";
 
-    // Write the .step file
-    write_step_file(relative_path, file_name, open_cascade_model);
+    // Hash the inputs of the model (the cache adds the settings of the STEP exporter to the key)
+    ModelHasher model_inputs;
+    model_inputs.add(P);
+    ExportCache export_cache;
+    string model_key = export_cache.key(model_inputs);
+
+    // Build the model and write the .step file only on a cache miss (the model stays null on a cache hit)
+    TopoDS_Shape open_cascade_model;
+    if (!export_cache.fetch(model_key, relative_path, file_name)) {
+        open_cascade_model = make_bezier_surface(P);
+        // Only a file that was written completely is stored in the cache
+        if (write_step_file(relative_path, file_name, open_cascade_model) == IFSelect_RetDone) {
+            export_cache.store(model_key, relative_path, file_name);
+        }
+    }
 
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Visualize the geometry in a graphical user interface (for instance the FreeCAD GUI)
     // -------------------------------------------------------------------------------------------------------------- //
-    string open_gui = "FreeCAD --single-instance " + relative_path + file_name + ".step";
-    system(open_gui.c_str());
+
+    // Write the preview product and open the GUI (skipped in headless mode)
+    stage_timer.start("view");
+    show_model(run_options, relative_path, file_name, open_cascade_model);
+
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
     return 0;
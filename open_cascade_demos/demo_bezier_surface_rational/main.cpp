@@ -8,14 +8,12 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <sys/stat.h>
 #include <cmath>
 
 
 // Include OpenCascade libraries
 #include <gp.hxx>
 #include <gp_Pnt.hxx>
-#include <gp_Trsf.hxx>
 #include <gp_Ax1.hxx>
 #include <gp_Ax2.hxx>
 
@@ -25,51 +23,34 @@
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopoDS_Compound.hxx>
 
 #include <BRep_Builder.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
-#include <BRepBuilderAPI_Transform.hxx>
 
-#include <STEPControl_Writer.hxx>
 
 
-// Setting namespaces
-using namespace std;
-
-
-// ------------------------------------------------------------------------------------------------------------------ //
-// Step file exporter
-// ------------------------------------------------------------------------------------------------------------------ //
-IFSelect_ReturnStatus
-write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
-
-    // Create the .step writer object
-    STEPControl_Writer step_writer;
-
-    // Set the type of .step representation
-    STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs;
-
-    // Create the output directory if it does not exist
-    mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
-
-    // Get the full path to the step file as a C-string
-    string temp = (relative_path + model_name + ".step");
-    Standard_CString file_name = temp.c_str();
+// Include the shared demo library
+#include "step_exporter.h"
+#include "run_options.h"
+#include "symmetric_model.h"
 
-    // Write the .step file
-    step_writer.Transfer(model_object, step_mode);
-    IFSelect_ReturnStatus status = step_writer.Write(file_name);
-    return status;
 
-}
+// Setting namespaces
+using namespace std;
 
 
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_bezier_surface_rational", run_options.timings);
+    stage_timer.start("model");
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Define the array of control points
@@ -124,38 +105,34 @@ int main() {
     // Define the geometry and topology of a rational Bezier surface patch
     // -------------------------------------------------------------------------------------------------------------- //
 
-    // Get the value of pi
-    const double pi = M_PI;
-
-    // Rotate the Bezier patch 90 degrees around the Z-axis
-    gp_Trsf myTransformation;                                           // Declare a transformation object
-    gp_Ax1 axisOfRotation = gp::OZ();                                   // Set Z as the axis of rotation
-    Standard_Real angleOfRotation = pi/2;                               // Set the angle of rotation
-    myTransformation.SetRotation(axisOfRotation, angleOfRotation);      // Set the transformation as a rotation
-    BRepBuilderAPI_Transform BRepT1(BezierFace, myTransformation);      // Apply the rotation to the Bezier patch
-    TopoDS_Shape temp = BRepT1.Shape();                                 // Retrieve the rotated bezier patch
-    TopoDS_Face BezierRotatedFace = TopoDS::Face(temp);                 // Cast the TopoDS_Shape into a TopoDS_Face
-
-    // Make a compound with the two bezier patches
-    TopoDS_Compound myCompound;                                         // Declare the TopoDS_Compound object
-    BRep_Builder myBuilder;                                             // Declare the compound builder object
-    myBuilder.MakeCompound (myCompound);                                // Start the compound creation
-    myBuilder.Add (myCompound, BezierFace);                             // Add the original Bezier patch
-    myBuilder.Add (myCompound, BezierRotatedFace);                      // Add the rotated Bezier patch
-
-    // Mirror the two Bezier patches in the XZ plane
-    gp_Ax2 planeOfReflexion = gp::ZOX();                                // Set the XY plane as the plane of symmetry
-    myTransformation.SetMirror(planeOfReflexion);                       // Set the transformation as a reflection
-    BRepBuilderAPI_Transform BRepT2(myCompound, myTransformation);      // Apply the mirroring to the compound
-    temp = BRepT2.Shape();                                              // Retrieve the rotated bezier patch
-    TopoDS_Compound CylinderMirrored = TopoDS::Compound(temp);          // Cast the TopoDS_Shape into a TopoDS_Compound
-    myBuilder.Add (myCompound, CylinderMirrored);                       // Add the mirrored patches to the compound
+    // Generate the full cylinder from the 90 degree patch with a symmetry group (see symmetric_model.h):
+    //  - two sectors: the original patch and the patch rotated 180 degrees around the Z-axis
+    //  - a mirror in the XZ plane, which contains the Z-axis: the mirror images of both patches
+    // The four elements of the group cover the four quadrants of the cylinder
+    SymmetryGroup symmetryGroup(gp::OZ(), 2);                           // Rotations by 0 and 180 degrees around Z
+    gp_Ax2 planeOfReflexion = gp::ZOX();                                // Set the XZ plane as the plane of symmetry
+    symmetryGroup.add_mirror_plane(planeOfReflexion);                   // Add the reflection to the group
+
+    // Choose how the patches are transformed:
+    //  - true: the rotated patches share the geometry of the original patch through their location, and the mirrored
+    //    patches share the geometry of a single mirrored patch (see located_transform.h)
+    //  - false: the geometry of every patch is copied by BRepBuilderAPI_Transform
+    const bool shareGeometry = true;
+
+    // Make a compound with the four Bezier patches
+    // The patches are independent, so they are built in parallel and then added to the compound in the same order
+    // whatever the number of threads (see parallel_build.h)
+    SymmetricModel symmetricModel(BezierFace, symmetryGroup);
+    TopoDS_Compound myCompound = symmetricModel.materialise(0, !shareGeometry);
 
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Export the model as a STEP file
     // -------------------------------------------------------------------------------------------------------------- //
 
+    // Start timing the export
+    stage_timer.start("export");
+
     // Create a TopoDS_Shape object to export as .step
     TopoDS_Shape open_cascade_model = myCompound;
 
@@ -170,8 +147,13 @@ int main() {
     // -------------------------------------------------------------------------------------------------------------- //
     // Visualize the geometry in a graphical user interface (for instance the FreeCAD GUI)
     // -------------------------------------------------------------------------------------------------------------- //
-    string open_gui = "FreeCAD --single-instance " + relative_path + file_name + ".step";
-    system(open_gui.c_str());
+
+    // Write the preview product and open the GUI (skipped in headless mode)
+    stage_timer.start("view");
+    show_model(run_options, relative_path, file_name, open_cascade_model);
+
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
 
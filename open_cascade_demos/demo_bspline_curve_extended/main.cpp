@@ -8,7 +8,6 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <sys/stat.h>
 #include <cmath>
 
 // Include OpenCascade libraries
@@ -20,44 +19,26 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
-#include <STEPControl_Writer.hxx>
 
 
-// Define namespaces
-using namespace std;
-
-
-// ------------------------------------------------------------------------------------------------------------------ //
-// Step file exporter
-// ------------------------------------------------------------------------------------------------------------------ //
-IFSelect_ReturnStatus
-write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
-
-    // Create the .step writer object
-    STEPControl_Writer step_writer;
-
-    // Set the type of .step representation
-    STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs;
-
-    // Create the output directory if it does not exist
-    mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
+// Include the shared demo library
+#include "step_exporter.h"
+#include "run_options.h"
 
-    // Get the full path to the step file as a C-string
-    string temp = (relative_path + model_name + ".step");
-    Standard_CString file_name = temp.c_str();
 
-    // Write the .step file
-    step_writer.Transfer(model_object, step_mode);
-    IFSelect_ReturnStatus status = step_writer.Write(file_name);
-    return status;
-
-}
+// Define namespaces
+using namespace std;
 
 
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_bspline_curve_extended", run_options.timings);
+    stage_timer.start("model");
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Define the array of control points
@@ -133,6 +114,9 @@ int main() {
     // Export the model as a STEP file
     // -------------------------------------------------------------------------------------------------------------- //
 
+    // Start timing the export
+    stage_timer.start("export");
+
     // Create a TopoDS_Shape object to export as .step
     TopoDS_Shape open_cascade_model = Face;
 
@@ -147,8 +131,13 @@ int main() {
     // -------------------------------------------------------------------------------------------------------------- //
     // Visualize the geometry in a graphical user interface (for instance the FreeCAD GUI)
     // -------------------------------------------------------------------------------------------------------------- //
-    string open_gui = "FreeCAD --single-instance " + relative_path + file_name + ".step";
-    system(open_gui.c_str());
+
+    // Write the preview product and open the GUI (skipped in headless mode)
+    stage_timer.start("view");
+    show_model(run_options, relative_path, file_name, open_cascade_model);
+
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
     return 0;
@@ -8,9 +8,10 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <fstream>
+#include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <climits>
 #include <sys/stat.h>
 
 
@@ -25,6 +26,12 @@
 #include <STEPControl_Writer.hxx>
 
 
+// Include the shared demo library
+#include "run_options.h"
+#include "bspline_law_evaluator.h"
+#include "sample_writer.h"
+
+
 // Define namespaces
 using namespace std;
 
@@ -32,7 +39,12 @@ using namespace std;
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_evolution_law", run_options.timings);
+    stage_timer.start("model");
 
 
     // -------------------------------------------------------------------------------------------------------------- //
@@ -141,7 +153,18 @@ int main() {
     // Evaluate the B-Spline law
     // -------------------------------------------------------------------------------------------------------------- //
 
-    int Nu = 101;
+    // Start timing the evaluation stage
+    stage_timer.start("evaluate");
+
+    // Number of samples (101 unless given with --samples)
+    // The step between the parameters needs at least two samples, and the OpenCascade arrays are indexed with an int
+    long number_of_samples = run_options.number_of_samples != 0 ? run_options.number_of_samples : 101;
+    if (number_of_samples < 2 || number_of_samples > INT_MAX) {
+        cerr << "The number of samples must be between 2 and " << INT_MAX << " (got " << number_of_samples << ")"
+             << endl;
+        return 1;
+    }
+    int Nu = int(number_of_samples);
     TColStd_Array1OfReal u(0, Nu-1);
 
     double a = 0.0, b = 1.00, step = (b-a)/(Nu-1);
@@ -149,15 +172,20 @@ int main() {
         u(i) = a + step*i;
     }
 
+    // Evaluate the law at all the (sorted) parameters at once (see bspline_law_evaluator.h)
+    // This gives the same values as calling bsplineLaw.Value(u(i)) for each parameter
     TColStd_Array1OfReal bsplineValues(0, Nu-1);
-    for (int i = 0; i < Nu; ++i) {
-        bsplineValues(i) = bsplineLaw.Value(u(i));
-    }
-
-    cout << "\n\nEvaluate the B-Spline law" << endl;
-    cout << setw(15) << "u-parameter" << setw(15) << "BSpline value" << endl;
-    for (int i = 0; i < Nu; ++i) {
-        cout << setw(15) << u(i)  << setw(15) << bsplineValues(i) << endl;
+    BSplineLawEvaluator bsplineEvaluator(bsplineLaw);
+    bsplineEvaluator.evaluate(&u(0), Nu, &bsplineValues(0));
+
+    // Print the samples (skipped with --quiet)
+    if (!run_options.quiet) {
+        cout << "\n\nEvaluate the B-Spline law" << endl;
+        cout << setw(15) << "u-parameter" << setw(15) << "BSpline value" << endl;
+        for (int i = 0; i < Nu; ++i) {
+            cout << setw(15) << u(i)  << setw(15) << bsplineValues(i) << '\n';
+        }
+        cout << flush;
     }
 
 
@@ -166,23 +194,27 @@ int main() {
     // Print the coordinates of the B-Spline law
     // -------------------------------------------------------------------------------------------------------------- //
 
-    // Create a file output object
-    ofstream bsplineFile;
+    // Start timing the write stage
+    stage_timer.start("write");
+
+    // Set the destination path and the name of the sample files
     string relative_path = "../output/";
-    string file_name = "bspline_law.csv";
+    string file_name = "bspline_law";
     mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
-    string full_path = relative_path + file_name;
-    bsplineFile.open (full_path);
-    bsplineFile.precision(8);
-    bsplineFile.setf(ios::fixed);
 
-    // Print the coordinates of the B-Spline law
-    for (int i = 0; i < Nu; ++i) {
-        bsplineFile << u(i) << ", " << bsplineValues(i) << endl;
+    // Write the samples in each requested format (csv by default, see sample_writer.h)
+    // The .npy file holds the array [u, f] and can be memory-mapped by plot_bspline.py
+    istringstream sample_formats(run_options.sample_format);
+    string sample_format;
+    while (getline(sample_formats, sample_format, ',')) {
+        string full_path = relative_path + file_name + "." + sample_format;
+        if (!write_samples(full_path, sample_format, {&u(0), &bsplineValues(0)}, size_t(Nu))) {
+            cerr << "Writing " << full_path << " failed" << endl;
+        }
     }
 
-    // Close the output file
-    bsplineFile.close();
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
     return 0;
@@ -19,8 +19,14 @@ import matplotlib.pyplot as plt
 # Create the figure
 # -------------------------------------------------------------------------------------------------------------------- #
 
-# Load the B-Spline law
-u, f = np.loadtxt("output/bspline_law.csv", delimiter=',').transpose()
+# Load the B-Spline law (memory-map the .npy file written with --sample-format=npy unless the .csv file is newer)
+npy_file, csv_file = "output/bspline_law.npy", "output/bspline_law.csv"
+use_npy = os.path.exists(npy_file) and (not os.path.exists(csv_file) or
+                                        os.path.getmtime(npy_file) >= os.path.getmtime(csv_file))
+if use_npy:
+    u, f = np.load(npy_file, mmap_mode='r')
+else:
+    u, f = np.loadtxt(csv_file, delimiter=',').transpose()
 
 # Create the figure
 fig = plt.figure(figsize=(6, 5))
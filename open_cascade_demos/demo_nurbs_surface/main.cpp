@@ -8,8 +8,8 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <sys/stat.h>
 #include <cmath>
+#include <vector>
 
 
 // Include OpenCascade libraries
@@ -17,11 +17,20 @@
 #include <Geom_BSplineSurface.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Wire.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Face.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
-#include <STEPControl_Writer.hxx>
+
+
+// Include the shared demo library
+#include "step_exporter.h"
+#include "run_options.h"
+#include "model_hash.h"
+#include "export_cache.h"
+#include "surface_grid_evaluator.h"
 
 
 // Define namespaces
@@ -29,28 +38,61 @@ using namespace std;
 
 
 // ------------------------------------------------------------------------------------------------------------------ //
-// Step file exporter
+// Define the geometry and topology of a NURBS surface patch
 // ------------------------------------------------------------------------------------------------------------------ //
-IFSelect_ReturnStatus
-write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
+TopoDS_Shape make_nurbs_surface(const TColgp_Array2OfPnt &P, const TColStd_Array2OfReal &W,
+                                const TColStd_Array1OfReal &U_values, const TColStd_Array1OfReal &V_values,
+                                const TColStd_Array1OfInteger &U_mults, const TColStd_Array1OfInteger &V_mults,
+                                Standard_Integer p, Standard_Integer q) {
 
-    // Create the .step writer object
-    STEPControl_Writer step_writer;
+    // Define the geometry of a NURBS surface referenced by handle
+    // Note that skipping the weights argument (W) reduces the NURBS surface to a B-Spline surface with unitary weights
+    Handle(Geom_BSplineSurface) BSplineGeo = new Geom_BSplineSurface(P, W, U_values, V_values, U_mults, V_mults, p, q, Standard_False, Standard_False);
 
-    // Set the type of .step representation
-    STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs;
+    // Define the topology of the NURBS surface
+    TopoDS_Face BSplineFace = BRepBuilderAPI_MakeFace(BSplineGeo, 0);
 
-    // Create the output directory if it does not exist
-    mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
+    // Create a TopoDS_Shape object to export as .step
+    TopoDS_Shape open_cascade_model = BSplineFace;
+    return open_cascade_model;
 
-    // Get the full path to the step file as a C-string
-    string temp = (relative_path + model_name + ".step");
-    Standard_CString file_name = temp.c_str();
+}
+
+
+// ------------------------------------------------------------------------------------------------------------------ //
+// Sample the surface of the patch on a grid of parameters and print its highest point (see surface_grid_evaluator.h)
+// ------------------------------------------------------------------------------------------------------------------ //
+void sample_nurbs_surface(const TopoDS_Shape &open_cascade_model) {
+
+    // Take the surface of the face instead of building it a second time
+    Handle(Geom_BSplineSurface) surface =
+            Handle(Geom_BSplineSurface)::DownCast(BRep_Tool::Surface(TopoDS::Face(open_cascade_model)));
+    if (surface.IsNull()) {
+        cerr << "Cannot sample the patch: the surface of the face is not a B-spline surface" << endl;
+        return;
+    }
+
+    // Grid of 101 x 101 equispaced parameters
+    Standard_Integer Nu = 101, Nv = 101;
+    vector<double> u_grid(Nu), v_grid(Nv);
+    for (int i = 0; i < Nu; ++i) { u_grid[i] = double(i) / double(Nu - 1); }
+    for (int j = 0; j < Nv; ++j) { v_grid[j] = double(j) / double(Nv - 1); }
+
+    // Positions and unit normals, one array per coordinate (the other quantities are not computed)
+    vector<vector<double>> positions(3, vector<double>(Nu * Nv)), normals(3, vector<double>(Nu * Nv));
+    SurfaceGridBuffers grid_buffers;
+    for (int d = 0; d < 3; ++d) {
+        grid_buffers.position[d] = positions[d].data();
+        grid_buffers.normal[d] = normals[d].data();
+    }
+    evaluate_surface_grid(surface, u_grid, v_grid, grid_buffers);
 
-    // Write the .step file
-    step_writer.Transfer(model_object, step_mode);
-    IFSelect_ReturnStatus status = step_writer.Write(file_name);
-    return status;
+    // Print the highest point of the grid and its normal
+    int highest = 0;
+    for (int k = 1; k < Nu * Nv; ++k) { if (positions[2][k] > positions[2][highest]) { highest = k; } }
+    cout << "Highest sample: (" << positions[0][highest] << ", " << positions[1][highest] << ", "
+         << positions[2][highest] << "), normal (" << normals[0][highest] << ", " << normals[1][highest] << ", "
+         << normals[2][highest] << ")" << endl;
 
 }
 
@@ -58,7 +100,12 @@ write_step_file(const string &relative_path, const string &model_name, const Top
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_nurbs_surface", run_options.timings);
+    stage_timer.start("model");
 
 
     // -------------------------------------------------------------------------------------------------------------- //
@@ -182,37 +229,44 @@ int main() {
 
 
     // -------------------------------------------------------------------------------------------------------------- //
-    // Define the geometry and topology of a NURBS surface patch
+    // Export the model as a STEP file (unless it was already exported from the same inputs)
     // -------------------------------------------------------------------------------------------------------------- //
 
-    // Define the geometry of a NURBS surface referenced by handle
-    // Note that skipping the weights argument (W) reduces the NURBS surface to a B-Spline surface with unitary weights
-    Handle(Geom_BSplineSurface) BSplineGeo = new Geom_BSplineSurface(P, W, U_values, V_values, U_mults, V_mults, p, q, Standard_False, Standard_False);
-
-    // Define the topology of the NURBS surface
-    TopoDS_Face BSplineFace = BRepBuilderAPI_MakeFace(BSplineGeo, 0);
-
-
-    // -------------------------------------------------------------------------------------------------------------- //
-    // Export the model as a STEP file
-    // -------------------------------------------------------------------------------------------------------------- //
-
-    // Create a TopoDS_Shape object to export as .step
-    TopoDS_Shape open_cascade_model = BSplineFace;
+    // Start timing the export
+    stage_timer.start("export");
 
     // Set the destination path and the name of the .step file
     string relative_path = "../output/";
     string file_name = "nurbs_surface";
 
-    // Write the .step file
-    write_step_file(relative_path, file_name, open_cascade_model);
+    // Hash the inputs of the model (the cache adds the settings of the STEP exporter to the key)
+    ModelHasher model_inputs;
+    model_inputs.add(P).add(W).add(U_values).add(V_values).add(U_mults).add(V_mults).add(p).add(q);
+    ExportCache export_cache;
+    string model_key = export_cache.key(model_inputs);
+
+    // Build and sample the model and write the .step file only on a cache miss (the model stays null on a cache hit)
+    TopoDS_Shape open_cascade_model;
+    if (!export_cache.fetch(model_key, relative_path, file_name)) {
+        open_cascade_model = make_nurbs_surface(P, W, U_values, V_values, U_mults, V_mults, p, q);
+        if (!run_options.quiet) { sample_nurbs_surface(open_cascade_model); }
+        // Only a file that was written completely is stored in the cache
+        if (write_step_file(relative_path, file_name, open_cascade_model) == IFSelect_RetDone) {
+            export_cache.store(model_key, relative_path, file_name);
+        }
+    }
 
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Visualize the geometry in a graphical user interface (for instance the FreeCAD GUI)
     // -------------------------------------------------------------------------------------------------------------- //
-    string open_gui = "FreeCAD --single-instance " + relative_path + file_name + ".step";
-    system(open_gui.c_str());
+
+    // Write the preview product and open the GUI (skipped in headless mode)
+    stage_timer.start("view");
+    show_model(run_options, relative_path, file_name, open_cascade_model);
+
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
     return 0;
@@ -9,7 +9,6 @@
 
 // Include standard C++ libraries
 #include <iostream>
-#include <sys/stat.h>
 #include <cmath>
 
 
@@ -25,44 +24,28 @@
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
-#include <STEPControl_Writer.hxx>
 
 
-// Define namespaces
-using namespace std;
-
-
-// ------------------------------------------------------------------------------------------------------------------ //
-// Step file exporter
-// ------------------------------------------------------------------------------------------------------------------ //
-IFSelect_ReturnStatus
-write_step_file(const string &relative_path, const string &model_name, const TopoDS_Shape &model_object) {
-
-    // Create the .step writer object
-    STEPControl_Writer step_writer;
-
-    // Set the type of .step representation
-    STEPControl_StepModelType step_mode = STEPControl_StepModelType::STEPControl_AsIs;
-
-    // Create the output directory if it does not exist
-    mkdir(relative_path.c_str(), 0777);     // 0007 is used to give the user permissions to read+write+execute
+// Include the shared demo library
+#include "step_exporter.h"
+#include "run_options.h"
+#include "hole_pattern.h"
+#include "hole_validator.h"
 
-    // Get the full path to the step file as a C-string
-    string temp = (relative_path + model_name + ".step");
-    Standard_CString file_name = temp.c_str();
 
-    // Write the .step file
-    step_writer.Transfer(model_object, step_mode);
-    IFSelect_ReturnStatus status = step_writer.Write(file_name);
-    return status;
-
-}
+// Define namespaces
+using namespace std;
 
 
 // ------------------------------------------------------------------------------------------------------------------ //
 // Main body
 // ------------------------------------------------------------------------------------------------------------------ //
-int main() {
+int main(int argc, char *argv[]) {
+
+    // Read the run options from the command line and the environment (see run_options.h)
+    RunOptions run_options = parse_run_options(argc, argv);
+    StageTimer stage_timer("demo_perforated_disk", run_options.timings);
+    stage_timer.start("model");
 
 
     // -------------------------------------------------------------------------------------------------------------- //
@@ -87,22 +70,28 @@ int main() {
     //Add inner bound. Must be reversed
     aBuilder.Add(aFace,wireIn.Reversed());
 
-    //Add more inner boundaries
+    //Add more inner boundaries: a circular pattern of holes of radius 0.1 on a circle of radius 1.5
+    //The hole wire is built once and every hole is a located copy of it (see hole_pattern.h)
     int nCuts = 30;
-    for(int i = 1 ; i < nCuts ; i++){
-        gp_Ax2 Ax(gp_Pnt(1.5,0,0),gp_Dir(0,0,1),gp_Dir(1,0,0));
-        TopoDS_Wire wire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(gp_Circ(Ax,0.1)));
-        gp_Trsf rot;
-        rot.SetRotation(gp_Ax1(gp_Pnt(),gp_Dir(0,0,1)),2.*M_PI*i/(nCuts-1.));
-        wire.Move(rot);
-        aBuilder.Add(aFace,wire.Reversed());
-    }
+    HolePattern holePattern;
+    holePattern.add_circular_pattern(0.1, 0., 0., 1.5, nCuts-1, 2.*M_PI/(nCuts-1.));
+
+    //Check that the holes lie inside the annulus and do not intersect each other before adding them
+    AnnularRegion annulus;
+    annulus.inner_radius = 1.;
+    annulus.outer_radius = 2.;
+    HoleValidationReport validation = holePattern.validate(annulus);
+    if (!validation.is_valid) { validation.print(cerr); return 1; }
+    holePattern.add_to_face(aFace);
 
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Export the model as a STEP file
     // -------------------------------------------------------------------------------------------------------------- //
 
+    // Start timing the export
+    stage_timer.start("export");
+
     // Create a TopoDS_Shape object to export as .step
     TopoDS_Shape open_cascade_model = aFace;
 
@@ -117,8 +106,13 @@ int main() {
     // -------------------------------------------------------------------------------------------------------------- //
     // Visualize the geometry in a graphical user interface (for instance the FreeCAD GUI)
     // -------------------------------------------------------------------------------------------------------------- //
-    string open_gui = "FreeCAD --single-instance " + relative_path + file_name + ".step";
-    system(open_gui.c_str());
+
+    // Write the preview product and open the GUI (skipped in headless mode)
+    stage_timer.start("view");
+    show_model(run_options, relative_path, file_name, open_cascade_model);
+
+    // Print the timings of the stages (only if requested)
+    stage_timer.report(cout);
 
 
 